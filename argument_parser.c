@@ -10,6 +10,7 @@
 #include "buffer.h"
 #include "common.h"
 #include "conversion.h"
+#include "environment.h"
 #include "interpreter.load_file.h"
 #include "math_unit.h"
 #include "property.h"
@@ -33,6 +34,7 @@ struct Parameters
 	uint8_t properties[BUFFER_SIZE_OF];
 	uint8_t target[BUFFER_SIZE_OF];
 	uint16_t encoding;
+	uint16_t jobs;
 	uint8_t debug;
 	uint8_t indent;
 	uint8_t module_priority;
@@ -41,6 +43,7 @@ struct Parameters
 	uint8_t program_help;
 	uint8_t project_help;
 	uint8_t quiet;
+	uint8_t stat_cache;
 	uint8_t verbose;
 };
 
@@ -58,6 +61,7 @@ static const uint8_t* arguments_0[] =
 	(const uint8_t*)"-projecthelp",
 	(const uint8_t*)"-q",
 	(const uint8_t*)"-quiet",
+	(const uint8_t*)"-statcache",
 	(const uint8_t*)"-verbose",
 	(const uint8_t*)"-v",
 	/**/
@@ -70,6 +74,7 @@ static const uint8_t* arguments_0[] =
 	(const uint8_t*)"-projecthelp+",
 	(const uint8_t*)"-q+",
 	(const uint8_t*)"-quiet+",
+	(const uint8_t*)"-statcache+",
 	(const uint8_t*)"-verbose+",
 	(const uint8_t*)"-v+",
 	/**/
@@ -82,6 +87,7 @@ static const uint8_t* arguments_0[] =
 	(const uint8_t*)"-projecthelp-",
 	(const uint8_t*)"-q-",
 	(const uint8_t*)"-quiet-",
+	(const uint8_t*)"-statcache-",
 	(const uint8_t*)"-verbose-",
 	(const uint8_t*)"-v-",
 };
@@ -158,6 +164,16 @@ void unset_quiet(struct Parameters* parameters)
 	parameters->quiet = 0;
 }
 
+void set_statcache(struct Parameters* parameters)
+{
+	parameters->stat_cache = 1;
+}
+
+void unset_statcache(struct Parameters* parameters)
+{
+	parameters->stat_cache = 0;
+}
+
 void set_verbose(struct Parameters* parameters)
 {
 	parameters->verbose = 1;
@@ -179,6 +195,7 @@ static const P_0 functions_0[] =
 	set_projecthelp,
 	set_quiet,
 	set_quiet,
+	set_statcache,
 	set_verbose,
 	set_verbose,
 	/**/
@@ -191,6 +208,7 @@ static const P_0 functions_0[] =
 	set_projecthelp,
 	set_quiet,
 	set_quiet,
+	set_statcache,
 	set_verbose,
 	set_verbose,
 	/**/
@@ -203,6 +221,7 @@ static const P_0 functions_0[] =
 	unset_projecthelp,
 	unset_quiet,
 	unset_quiet,
+	unset_statcache,
 	unset_verbose,
 	unset_verbose,
 };
@@ -214,6 +233,7 @@ static const uint8_t* arguments_1[] =
 	(const uint8_t*)"-encoding:",
 	(const uint8_t*)"/f:",
 	(const uint8_t*)"-indent:",
+	(const uint8_t*)"-jobs:",
 	(const uint8_t*)"-l:",
 	(const uint8_t*)"-listener:",
 	(const uint8_t*)"-logfile:",
@@ -266,6 +286,22 @@ uint8_t set_indent(struct Parameters* parameters, const char* argument, ptrdiff_
 	return 1;
 }
 
+uint8_t set_jobs(struct Parameters* parameters, const char* argument, ptrdiff_t i, ptrdiff_t length)
+{
+	const int32_t jobs = int_parse((const uint8_t*)(argument + i), (const uint8_t*)(argument + length));
+
+	if (jobs < 1)
+	{
+		parameters->jobs = environment_processor_count();
+	}
+	else
+	{
+		parameters->jobs = (uint16_t)MIN(jobs, UINT16_MAX);
+	}
+
+	return 1;
+}
+
 uint8_t set_listener(struct Parameters* parameters, const char* argument, ptrdiff_t i, ptrdiff_t length)
 {
 	return buffer_resize(&(parameters->listener), 0) &&
@@ -287,6 +323,7 @@ static const P_1 functions_1[] =
 	set_encoding,
 	set_buildfile,
 	set_indent,
+	set_jobs,
 	set_logfile,
 	set_listener,
 	set_logfile,
@@ -593,12 +630,14 @@ uint8_t argument_parser_init()
 	parameters_.debug = 0;
 	parameters_.encoding = UTF8;
 	parameters_.indent = 0;
+	parameters_.jobs = 1;
 	parameters_.module_priority = 0;
 	parameters_.no_logo = 0;
 	parameters_.pause = 0;
 	parameters_.program_help = 0;
 	parameters_.project_help = 0;
 	parameters_.quiet = 0;
+	parameters_.stat_cache = 0;
 	parameters_.verbose = 0;
 	/**/
 	return 1;
@@ -842,6 +881,11 @@ uint8_t argument_parser_get_quiet()
 	return parameters_.quiet;
 }
 
+uint8_t argument_parser_get_stat_cache()
+{
+	return parameters_.stat_cache;
+}
+
 uint8_t argument_parser_get_verbose()
 {
 	return parameters_.verbose;
@@ -852,6 +896,11 @@ uint16_t argument_parser_get_encoding()
 	return parameters_.encoding;
 }
 
+uint16_t argument_parser_get_jobs()
+{
+	return parameters_.jobs;
+}
+
 const void* argument_parser_get_properties()
 {
 	return (const void*)(&parameters_.properties);
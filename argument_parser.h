@@ -38,8 +38,10 @@ uint8_t argument_parser_get_pause();
 uint8_t argument_parser_get_program_help();
 uint8_t argument_parser_get_project_help();
 uint8_t argument_parser_get_quiet();
+uint8_t argument_parser_get_stat_cache();
 uint8_t argument_parser_get_verbose();
 uint16_t argument_parser_get_encoding();
+uint16_t argument_parser_get_jobs();
 
 const void* argument_parser_get_properties();
 
@@ -22,11 +22,53 @@ struct buffer
 	ptrdiff_t capacity;
 };
 
-static struct buffer pool;
-static uint8_t is_pool_init = 0;
+struct buffer_pool_entry
+{
+	struct buffer the_buffer;
+	struct buffer_pool_entry* next_free;
+	uint8_t is_free;
+};
+
+#define POOL_BINS_COUNT				(8 * sizeof(ptrdiff_t))
+#define POOL_MINIMAL_CHUNK_COUNT	64
+#define POOL_MAXIMUM_CHUNKS_COUNT	16
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+/*NOTE: pool, same as arena, owned by the thread, so buffer should be returned at the thread that took it.*/
+static THREAD_LOCAL struct buffer pool;
+static THREAD_LOCAL uint8_t is_pool_init = 0;
+static THREAD_LOCAL struct buffer_pool_entry* pool_bins[POOL_BINS_COUNT];
+static THREAD_LOCAL ptrdiff_t pool_hits = 0;
+static THREAD_LOCAL ptrdiff_t pool_misses = 0;
+
+struct buffer_arena
+{
+	uint8_t* blocks[64];
+	ptrdiff_t blocks_count;
+	ptrdiff_t position;
+	ptrdiff_t depth;
+};
+
+struct buffer_arena_header
+{
+	ptrdiff_t depth;
+	ptrdiff_t capacity;
+};
 
-#if defined(_WIN64) || defined(__amd64) || defined(__x86_64)
-static const ptrdiff_t maximum_capacity = (ptrdiff_t)(INT32_MAX) + 1;
+#define ARENA_BLOCK_SIZE			65536
+#define ARENA_MAXIMUM_BLOCKS_COUNT	64
+#define ARENA_MAXIMUM_ALLOCATION	(ARENA_BLOCK_SIZE / 4)
+
+static THREAD_LOCAL struct buffer_arena arena;
+
+#if defined(_WIN64) || defined(__amd64) || defined(__x86_64) || (INT32_MAX < PTRDIFF_MAX)
+/*NOTE: at 64 bit targets content of file larger than 2 GB can be kept at the buffer.*/
+static const ptrdiff_t maximum_capacity = (ptrdiff_t)1 << 62;
 #else
 static const ptrdiff_t maximum_capacity = 1073741824;
 #endif
@@ -43,25 +85,167 @@ ptrdiff_t buffer_calculate_capacity(const ptrdiff_t size)
 	return capacity < maximum_capacity ? capacity : maximum_capacity;
 }
 
-struct buffer* buffer_to_real_buffer(const void* the_buffer)
+struct buffer_pool_entry* buffer_to_pool_entry(const void* the_buffer)
 {
-	void* real_buffer = NULL;
+	void* chunk = NULL;
 	ptrdiff_t i = 0;
 
 	if (NULL == the_buffer)
 	{
-		return real_buffer;
+		return NULL;
 	}
 
-	while (NULL != (real_buffer = buffer_buffer_data(&pool, i++)))
+	while (NULL != (chunk = buffer_buffer_data(&pool, i++)))
 	{
-		if (the_buffer == real_buffer)
+		const uint8_t* start = (const uint8_t*)((const struct buffer*)chunk)->data;
+		const uint8_t* finish = start + ((const struct buffer*)chunk)->size;
+
+		if (start <= (const uint8_t*)the_buffer && (const uint8_t*)the_buffer < finish)
 		{
-			break;
+			if (0 != ((const uint8_t*)the_buffer - start) % sizeof(struct buffer_pool_entry))
+			{
+				return NULL;
+			}
+
+			return (struct buffer_pool_entry*)the_buffer;
 		}
 	}
 
-	return (struct buffer*)real_buffer;
+	return NULL;
+}
+
+uint8_t buffer_pool_get_bin(ptrdiff_t capacity)
+{
+	uint8_t bin = 0;
+
+	while (0 < capacity && bin < POOL_BINS_COUNT - 1)
+	{
+		capacity = capacity >> 1;
+		++bin;
+	}
+
+	return bin;
+}
+
+uint8_t buffer_arena_is_owner(const void* data)
+{
+	if (NULL == data)
+	{
+		return 0;
+	}
+
+	for (ptrdiff_t i = 0; i < arena.blocks_count; ++i)
+	{
+		if (arena.blocks[i] <= (const uint8_t*)data &&
+			(const uint8_t*)data < arena.blocks[i] + ARENA_BLOCK_SIZE)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void* buffer_arena_allocate(ptrdiff_t depth, ptrdiff_t capacity)
+{
+	if (depth < 1 ||
+		depth != arena.depth ||
+		ARENA_MAXIMUM_ALLOCATION < capacity)
+	{
+		return NULL;
+	}
+
+	const ptrdiff_t alignment = sizeof(struct buffer_arena_header);
+	const ptrdiff_t size = alignment + (capacity + alignment - 1) / alignment * alignment;
+	ptrdiff_t block = arena.position / ARENA_BLOCK_SIZE;
+	ptrdiff_t offset = arena.position % ARENA_BLOCK_SIZE;
+
+	if (ARENA_BLOCK_SIZE < offset + size)
+	{
+		++block;
+		offset = 0;
+	}
+
+	if (arena.blocks_count <= block)
+	{
+		if (ARENA_MAXIMUM_BLOCKS_COUNT <= block)
+		{
+			return NULL;
+		}
+
+		arena.blocks[block] = (uint8_t*)malloc(ARENA_BLOCK_SIZE);
+
+		if (NULL == arena.blocks[block])
+		{
+			return NULL;
+		}
+
+		arena.blocks_count = block + 1;
+	}
+
+	struct buffer_arena_header* header = (struct buffer_arena_header*)(arena.blocks[block] + offset);
+	header->depth = depth;
+	header->capacity = capacity;
+	arena.position = block * ARENA_BLOCK_SIZE + offset + size;
+	/**/
+	return header + 1;
+}
+
+ptrdiff_t buffer_arena_get_depth(const struct buffer* the_buffer)
+{
+	if (the_buffer->capacity < 0)
+	{
+		return -the_buffer->capacity;
+	}
+
+	if (buffer_arena_is_owner(the_buffer->data))
+	{
+		return ((const struct buffer_arena_header*)the_buffer->data - 1)->depth;
+	}
+
+	return 0;
+}
+
+void* buffer_allocate(const struct buffer* the_buffer, ptrdiff_t capacity)
+{
+	void* data = buffer_arena_allocate(buffer_arena_get_depth(the_buffer), capacity);
+	return NULL == data ? malloc(capacity) : data;
+}
+
+void buffer_free(void* data)
+{
+	if (!buffer_arena_is_owner(data))
+	{
+		free(data);
+	}
+}
+
+ptrdiff_t buffer_arena_begin()
+{
+	++arena.depth;
+	return arena.position;
+}
+
+void buffer_arena_end(ptrdiff_t position)
+{
+	if (0 < arena.depth)
+	{
+		--arena.depth;
+		arena.position = position;
+	}
+}
+
+void buffer_arena_release()
+{
+	for (ptrdiff_t i = 0; i < arena.blocks_count; ++i)
+	{
+		free(arena.blocks[i]);
+		arena.blocks[i] = NULL;
+	}
+
+	arena.blocks_count = 0;
+	arena.position = 0;
+	arena.depth = 0;
 }
 
 uint8_t buffer_size_of()
@@ -80,6 +264,17 @@ uint8_t buffer_init(void* the_buffer, uint8_t size_of_buffer)
 	return 1;
 }
 
+uint8_t buffer_init_at_arena(void* the_buffer, uint8_t size_of_buffer)
+{
+	if (!buffer_init(the_buffer, size_of_buffer))
+	{
+		return 0;
+	}
+
+	((struct buffer*)the_buffer)->capacity = -arena.depth;
+	return 1;
+}
+
 ptrdiff_t buffer_size(const void* the_buffer)
 {
 	return NULL == the_buffer ? 0 : ((const struct buffer*)the_buffer)->size;
@@ -94,7 +289,7 @@ uint8_t buffer_resize(void* the_buffer_, ptrdiff_t size)
 		return 0;
 	}
 
-	if (the_buffer->capacity < size)
+	if ((the_buffer->capacity < 0 ? 0 : the_buffer->capacity) < size)
 	{
 		const ptrdiff_t capacity = buffer_calculate_capacity(size);
 
@@ -103,15 +298,17 @@ uint8_t buffer_resize(void* the_buffer_, ptrdiff_t size)
 			return 0;
 		}
 
+		void* new_data = buffer_allocate(the_buffer, capacity);
+
 		if (NULL != the_buffer->data)
 		{
-			free(the_buffer->data);
+			buffer_free(the_buffer->data);
 			the_buffer->data = NULL;
 			the_buffer->size = 0;
 			the_buffer->capacity = 0;
 		}
 
-		the_buffer->data = malloc(capacity);
+		the_buffer->data = new_data;
 
 		if (NULL == the_buffer->data)
 		{
@@ -136,7 +333,7 @@ void buffer_release(void* the_buffer_)
 
 	if (NULL != the_buffer->data)
 	{
-		free(the_buffer->data);
+		buffer_free(the_buffer->data);
 		the_buffer->data = NULL;
 	}
 
@@ -177,12 +374,14 @@ uint8_t buffer_append(void* the_buffer_, const void* data, ptrdiff_t size)
 
 	if (the_buffer->capacity - the_buffer->size < size)
 	{
-		if ((maximum_capacity - the_buffer->capacity) < size)
+		const ptrdiff_t current_capacity = the_buffer->capacity < 0 ? 0 : the_buffer->capacity;
+
+		if ((maximum_capacity - current_capacity) < size)
 		{
 			return 0;
 		}
 
-		const ptrdiff_t new_size = the_buffer->capacity + size;
+		const ptrdiff_t new_size = current_capacity + size;
 		const ptrdiff_t capacity = buffer_calculate_capacity(new_size);
 
 		if (capacity < new_size)
@@ -190,7 +389,7 @@ uint8_t buffer_append(void* the_buffer_, const void* data, ptrdiff_t size)
 			return 0;
 		}
 
-		void* new_data = malloc(capacity);
+		void* new_data = buffer_allocate(the_buffer, capacity);
 
 		if (NULL == new_data)
 		{
@@ -203,7 +402,7 @@ uint8_t buffer_append(void* the_buffer_, const void* data, ptrdiff_t size)
 
 			if (0 != memcpy_s(new_data, capacity, the_buffer->data, the_buffer->size))
 			{
-				free(new_data);
+				buffer_free(new_data);
 				new_data = NULL;
 				return 0;
 			}
@@ -215,7 +414,7 @@ uint8_t buffer_append(void* the_buffer_, const void* data, ptrdiff_t size)
 
 		if (NULL != the_buffer->data)
 		{
-			free(the_buffer->data);
+			buffer_free(the_buffer->data);
 		}
 
 		the_buffer->data = new_data;
@@ -332,7 +531,8 @@ uint8_t buffer_shrink_to_fit(void* the_buffer_)
 {
 	struct buffer* the_buffer = (struct buffer*)the_buffer_;
 
-	if (NULL == the_buffer || the_buffer->size < 0 || the_buffer->capacity < 512)
+	if (NULL == the_buffer || the_buffer->size < 0 || the_buffer->capacity < 512 ||
+		buffer_arena_is_owner(the_buffer->data))
 	{
 		return 0;
 	}
@@ -348,7 +548,6 @@ uint8_t buffer_shrink_to_fit(void* the_buffer_)
 			return 0;
 		}
 
-		free(the_buffer->data);
 		the_buffer->data = new_data;
 		the_buffer->capacity = capacity;
 		return 1;
@@ -359,12 +558,6 @@ uint8_t buffer_shrink_to_fit(void* the_buffer_)
 
 uint8_t buffer_init_pool(void** the_buffer)
 {
-	static const ptrdiff_t pool_limit = (ptrdiff_t)(sizeof(struct buffer) * UINT8_MAX);
-	struct buffer* current_buffer = NULL;
-	struct buffer* candidate_buffer = NULL;
-	ptrdiff_t i = 0;
-	ptrdiff_t capacity = 0;
-
 	if (NULL == the_buffer)
 	{
 		return 0;
@@ -373,62 +566,106 @@ uint8_t buffer_init_pool(void** the_buffer)
 	if (!is_pool_init)
 	{
 		if (!buffer_init(&pool, sizeof(struct buffer)) ||
-			!buffer_append(&pool, NULL, pool_limit) ||
+			!buffer_append(&pool, NULL, sizeof(struct buffer) * POOL_MAXIMUM_CHUNKS_COUNT) ||
 			!buffer_resize(&pool, 0))
 		{
 			buffer_release(&pool);
 			return 0;
 		}
 
+		memset(pool_bins, 0, sizeof(pool_bins));
 		is_pool_init = 1;
 	}
 
-	while (NULL != (current_buffer = buffer_buffer_data(&pool, i++)))
+	for (uint8_t bin = POOL_BINS_COUNT; 0 < bin; --bin)
 	{
-		if (buffer_size(current_buffer) < 0 && capacity < current_buffer->capacity)
+		struct buffer_pool_entry* entry = pool_bins[bin - 1];
+
+		if (NULL != entry)
 		{
-			capacity = current_buffer->capacity;
-			candidate_buffer = current_buffer;
+			pool_bins[bin - 1] = entry->next_free;
+			entry->next_free = NULL;
+			entry->is_free = 0;
+			entry->the_buffer.size = 0;
+			++pool_hits;
+			/**/
+			*the_buffer = &entry->the_buffer;
+			return 1;
 		}
 	}
 
-	if (NULL != candidate_buffer)
-	{
-		candidate_buffer->size = 0;
-		*the_buffer = candidate_buffer;
-	}
-	else if (buffer_size(&pool) < pool_limit)
+	++pool_misses;
+	const ptrdiff_t chunks_count = buffer_size(&pool) / sizeof(struct buffer);
+	struct buffer* chunk = (struct buffer*)buffer_buffer_data(&pool, chunks_count - 1);
+
+	if (NULL == chunk ||
+		chunk->capacity < chunk->size + (ptrdiff_t)sizeof(struct buffer_pool_entry))
 	{
-		struct buffer new_buffer;
+		if (POOL_MAXIMUM_CHUNKS_COUNT <= chunks_count)
+		{
+			return 0;
+		}
+
+		struct buffer new_chunk;
 
-		if (!buffer_init(&new_buffer, sizeof(struct buffer)) ||
-			!buffer_append_buffer(&pool, &new_buffer, 1))
+		const ptrdiff_t size = sizeof(struct buffer_pool_entry) * ((ptrdiff_t)POOL_MINIMAL_CHUNK_COUNT << chunks_count);
+
+		if (!buffer_init(&new_chunk, sizeof(struct buffer)) ||
+			!buffer_append(&new_chunk, NULL, size) ||
+			!buffer_resize(&new_chunk, 0))
 		{
+			buffer_release(&new_chunk);
 			return 0;
 		}
-		else
+
+		if (!buffer_append_buffer(&pool, &new_chunk, 1))
 		{
-			*the_buffer = buffer_buffer_data(&pool, i - 1);
+			buffer_release(&new_chunk);
+			return 0;
 		}
+
+		chunk = (struct buffer*)buffer_buffer_data(&pool, chunks_count);
 	}
-	else
+
+	struct buffer_pool_entry new_entry;
+
+	if (!buffer_init(&new_entry.the_buffer, sizeof(struct buffer)))
 	{
 		return 0;
 	}
 
+	new_entry.next_free = NULL;
+	new_entry.is_free = 0;
+	/*NOTE: capacity of the chunk reserved, so entry will not be moved.*/
+	const ptrdiff_t size = buffer_size(chunk);
+
+	if (!buffer_append(chunk, &new_entry, sizeof(struct buffer_pool_entry)))
+	{
+		return 0;
+	}
+
+	*the_buffer = buffer_data(chunk, size);
 	return NULL != *the_buffer;
 }
 
 uint8_t buffer_return_to_pool(void* the_buffer)
 {
-	struct buffer* real_buffer = buffer_to_real_buffer(the_buffer);
+	struct buffer_pool_entry* entry = buffer_to_pool_entry(the_buffer);
 
-	if (NULL == real_buffer)
+	if (NULL == entry)
 	{
 		return 0;
 	}
 
-	real_buffer->size = -1;
+	if (!entry->is_free)
+	{
+		const uint8_t bin = buffer_pool_get_bin(entry->the_buffer.capacity);
+		entry->next_free = pool_bins[bin];
+		entry->is_free = 1;
+		pool_bins[bin] = entry;
+	}
+
+	entry->the_buffer.size = -1;
 	return 1;
 }
 
@@ -436,27 +673,53 @@ uint8_t buffer_release_pool()
 {
 	if (is_pool_init)
 	{
-		void* current_buffer = NULL;
+		void* chunk = NULL;
 		ptrdiff_t i = 0;
 		uint8_t pool_is_free = 1;
 
-		while (NULL != (current_buffer = buffer_buffer_data(&pool, i++)))
+		while (NULL != (chunk = buffer_buffer_data(&pool, i++)))
 		{
-			if (pool_is_free && !(buffer_size(current_buffer) < 0))
+			ptrdiff_t j = 0;
+			struct buffer_pool_entry* entry = NULL;
+
+			while (NULL != (entry = (struct buffer_pool_entry*)buffer_data(
+										chunk, sizeof(struct buffer_pool_entry) * j++)))
 			{
-				pool_is_free = 0;
+				if (pool_is_free && !entry->is_free)
+				{
+					pool_is_free = 0;
+				}
+
+				buffer_release(&entry->the_buffer);
 			}
 
-			buffer_release(current_buffer);
+			buffer_release(chunk);
 		}
 
 		buffer_release(&pool);
+		memset(pool_bins, 0, sizeof(pool_bins));
+		is_pool_init = 0;
 		return pool_is_free;
 	}
-	else
+
+	return 1;
+}
+
+void buffer_get_pool_statistics(ptrdiff_t* hits, ptrdiff_t* misses)
+{
+	if (NULL != hits)
+	{
+		*hits = pool_hits;
+	}
+
+	if (NULL != misses)
 	{
-		is_pool_init = buffer_init(&pool, sizeof(struct buffer));
+		*misses = pool_misses;
 	}
+}
 
-	return is_pool_init;
+void buffer_add_pool_statistics(ptrdiff_t hits, ptrdiff_t misses)
+{
+	pool_hits += hits;
+	pool_misses += misses;
 }
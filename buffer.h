@@ -17,6 +17,7 @@
 uint8_t buffer_size_of();
 
 uint8_t buffer_init(void* the_buffer, uint8_t size_of_buffer);
+uint8_t buffer_init_at_arena(void* the_buffer, uint8_t size_of_buffer);
 
 ptrdiff_t buffer_size(const void* the_buffer);
 
@@ -48,5 +49,11 @@ uint8_t buffer_shrink_to_fit(void* the_buffer);
 uint8_t buffer_init_pool(void** the_buffer);
 uint8_t buffer_return_to_pool(void* the_buffer);
 uint8_t buffer_release_pool();
+void buffer_get_pool_statistics(ptrdiff_t* hits, ptrdiff_t* misses);
+void buffer_add_pool_statistics(ptrdiff_t hits, ptrdiff_t misses);
+
+ptrdiff_t buffer_arena_begin();
+void buffer_arena_end(ptrdiff_t position);
+void buffer_arena_release();
 
 #endif
@@ -11,6 +11,7 @@
 #include "common.h"
 #include "conversion.h"
 #include "interpreter.h"
+#include "project.h"
 #include "range.h"
 #include "string_unit.h"
 #include "xml.h"
@@ -51,7 +52,7 @@ uint8_t choose_evaluate_task(
 	sub_nodes_names.start = tags;
 	sub_nodes_names.finish = sub_nodes_names.start + 15;
 	const uint16_t count = xml_get_sub_nodes_elements(
-							   attributes_finish, element_finish,
+							   project_get_xml_index(the_project), attributes_finish, element_finish,
 							   &sub_nodes_names, elements);
 
 	if (!count)
@@ -122,7 +123,8 @@ uint8_t choose_evaluate_task(
 			return 0;
 		}
 
-		return xml_get_sub_nodes_elements(attributes_finish, element_finish, NULL, elements) ?
+		return xml_get_sub_nodes_elements(
+				project_get_xml_index(the_project), attributes_finish, element_finish, NULL, elements) ?
 			   interpreter_evaluate_tasks(the_project, the_target, elements, NULL, 0, verbose) : 1;
 	}
 
@@ -139,7 +141,8 @@ uint8_t choose_evaluate_task(
 			return 0;
 		}
 
-		return xml_get_sub_nodes_elements(attributes_finish, element_finish, NULL, elements) ?
+		return xml_get_sub_nodes_elements(
+				project_get_xml_index(the_project), attributes_finish, element_finish, NULL, elements) ?
 			   interpreter_evaluate_tasks(the_project, the_target, elements, NULL, 0, verbose) : 1;
 	}
 
@@ -252,6 +252,18 @@ uint8_t common_get_module_priority()
 	return module_priority;
 }
 
+static uint16_t jobs = 1;
+
+void common_set_jobs(uint16_t count)
+{
+	jobs = 0 < count ? count : 1;
+}
+
+uint16_t common_get_jobs()
+{
+	return jobs;
+}
+
 const uint8_t* common_get_string_at(
 	const uint8_t* start, const uint8_t* finish,
 	ptrdiff_t x, ptrdiff_t y)
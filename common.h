@@ -54,6 +54,9 @@ uint8_t common_is_error_output_stream_standard();
 void common_set_module_priority(uint8_t priority);
 uint8_t common_get_module_priority();
 
+void common_set_jobs(uint16_t count);
+uint16_t common_get_jobs();
+
 const uint8_t* common_get_string_at(
 	const uint8_t* start, const uint8_t* finish,
 	ptrdiff_t x, ptrdiff_t y);
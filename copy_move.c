@@ -10,7 +10,9 @@
 #include "buffer.h"
 #include "common.h"
 #include "conversion.h"
+#include "echo.h"
 #include "file_system.h"
+#include "interpreter.h"
 #include "interpreter.load_file.h"
 #include "load_file.h"
 #include "path.h"
@@ -18,8 +20,10 @@
 #include "range.h"
 #include "string_unit.h"
 #include "text_encoding.h"
+#include "thread.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #define COPY_MOVE_DIR					0
 #define COPY_MOVE_FILE					1
@@ -30,6 +34,11 @@
 #define COPY_MOVE_INPUT_ENCODING		6
 #define COPY_MOVE_OUTPUT_ENCODING		7
 #define COPY_MOVE_INCLUDE_EMPTY_DIRS	8
+#define COPY_MOVE_PRESERVE_LAST_MODIFIED	9
+#define COPY_MOVE_THREADS				10
+#define COPY_MOVE_SKIP_UNCHANGED		11
+#define COPY_MOVE_CHECKSUM				12
+#define COPY_MOVE_EXCLUDE				13
 
 static const uint8_t* copy_move_attributes[] =
 {
@@ -41,10 +50,15 @@ static const uint8_t* copy_move_attributes[] =
 	(const uint8_t*)"overwrite",
 	(const uint8_t*)"inputencoding",
 	(const uint8_t*)"outputencoding",
-	(const uint8_t*)"includeemptydirs"
+	(const uint8_t*)"includeemptydirs",
+	(const uint8_t*)"preservelastmodified",
+	(const uint8_t*)"threads",
+	(const uint8_t*)"skipunchanged",
+	(const uint8_t*)"checksum",
+	(const uint8_t*)"exclude"
 };
 
-static const uint8_t copy_move_attributes_lengths[] = { 3, 4, 5, 6, 7, 9, 13, 14, 16 };
+static const uint8_t copy_move_attributes_lengths[] = { 3, 4, 5, 6, 7, 9, 13, 14, 16, 20, 7, 13, 8, 7 };
 
 uint8_t copy_move_get_attributes_and_arguments_for_task(
 	const uint8_t*** task_attributes, const uint8_t** task_attributes_lengths,
@@ -58,6 +72,7 @@ uint8_t copy_move_get_attributes_and_arguments_for_task(
 }
 
 enum file_system_tasks { file_system_copy_task, file_system_move_task };
+enum copy_move_outcomes { copy_move_not_processed, copy_move_processed, copy_move_up_to_date };
 
 uint8_t copy_move_file_with_encoding(
 	uint8_t task_id, const uint8_t* source, const uint8_t* target,
@@ -73,10 +88,97 @@ uint8_t copy_move_file_with_encoding(
 	return 0;
 }
 
+uint8_t copy_move_is_unchanged(
+	const uint8_t* source, const uint8_t* target, const struct range* checksum)
+{
+	if (file_get_length(source) != file_get_length(target))
+	{
+		return 0;
+	}
+
+	if (range_is_null_or_empty(checksum))
+	{
+		/*NOTE: copy get time of the source, so change of any side make the times differ.*/
+		return file_get_last_write_time_precise(source) == file_get_last_write_time_precise(target);
+	}
+
+	uint8_t hashes_buffer[BUFFER_SIZE_OF];
+	void* hashes = (void*)hashes_buffer;
+
+	if (!buffer_init(hashes, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	if (!file_get_checksum(source, checksum, NULL, hashes))
+	{
+		buffer_release(hashes);
+		return 0;
+	}
+
+	const ptrdiff_t size = buffer_size(hashes);
+
+	if (!file_get_checksum(target, checksum, NULL, hashes))
+	{
+		buffer_release(hashes);
+		return 0;
+	}
+
+	const uint8_t* start = buffer_uint8_t_data(hashes, 0);
+	const uint8_t returned = string_equal(start, start + size, start + size, start + buffer_size(hashes));
+	buffer_release(hashes);
+	/**/
+	return returned;
+}
+
+uint8_t copy_move_report_file(
+	uint8_t task_id, const uint8_t* source, const uint8_t* target, uint8_t outcome, uint8_t verbose)
+{
+	if (!verbose ||
+		copy_move_not_processed == outcome)
+	{
+		return 1;
+	}
+
+	uint8_t message_buffer[BUFFER_SIZE_OF];
+	void* message = (void*)message_buffer;
+
+	if (!buffer_init(message, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	uint8_t result;
+
+	if (copy_move_up_to_date == outcome)
+	{
+		result = buffer_append_char(message, "Skipped up-to-date '", 20);
+	}
+	else
+	{
+		result = (file_system_copy_task == task_id ?
+				  buffer_append_char(message, "Copied '", 8) :
+				  buffer_append_char(message, "Moved '", 7)) &&
+				 buffer_append(message, source, common_count_bytes_until(source, 0)) &&
+				 buffer_append_char(message, "' to '", 6);
+	}
+
+	result = result &&
+			 buffer_append(message, target, common_count_bytes_until(target, 0)) &&
+			 buffer_append_char(message, "'.", 2) &&
+			 echo(0, Default, NULL, Verbose,
+				  buffer_uint8_t_data(message, 0), buffer_size(message), 1, verbose);
+	buffer_release(message);
+	/**/
+	return result;
+}
+
 uint8_t copy_move_file(uint8_t task_id, const uint8_t* source,
 					   const uint8_t** out_files, uint8_t count,
 					   uint16_t input_encoding, uint8_t output_encoding,
-					   uint8_t over_write, uint8_t verbose)
+					   uint8_t over_write, uint8_t preserve_last_modified,
+					   const struct range* checksum, ptrdiff_t* counters,
+					   uint8_t* outcomes, uint8_t verbose)
 {
 	if (NULL == source ||
 		NULL == out_files)
@@ -91,7 +193,37 @@ uint8_t copy_move_file(uint8_t task_id, const uint8_t* source,
 			continue;
 		}
 
-		if (over_write)
+		if (NULL != checksum &&
+			over_write &&
+			file_system_copy_task == task_id &&
+			file_exists(out_files[i]))
+		{
+			if (copy_move_is_unchanged(source, out_files[i], checksum))
+			{
+				if (NULL != counters)
+				{
+					++counters[1];
+				}
+
+				/*NOTE: worker only mark the outcome, so messages are printed in the enumeration order.*/
+				if (NULL != outcomes)
+				{
+					outcomes[i] = copy_move_up_to_date;
+				}
+				else if (!copy_move_report_file(task_id, source, out_files[i], copy_move_up_to_date, verbose))
+				{
+					return 0;
+				}
+
+				continue;
+			}
+
+			if (!file_delete(out_files[i]))
+			{
+				return 0;
+			}
+		}
+		else if (over_write)
 		{
 			if (file_exists(out_files[i]) &&
 				!file_delete(out_files[i]))
@@ -114,7 +246,8 @@ uint8_t copy_move_file(uint8_t task_id, const uint8_t* source,
 			Default == output_encoding)
 		{
 			result = file_system_copy_task == task_id ?
-					 file_copy(source, out_files[i]) :
+					 file_copy_with_attributes(source, out_files[i],
+											   preserve_last_modified ? 1 : (NULL != checksum ? FILE_COPY_PRESERVE_LAST_WRITE_TIME : 0)) :
 					 file_move(source, out_files[i]);
 		}
 		else
@@ -128,24 +261,37 @@ uint8_t copy_move_file(uint8_t task_id, const uint8_t* source,
 		{
 			return 0;
 		}
+
+		if (NULL != counters)
+		{
+			++counters[0];
+		}
+
+		if (NULL != outcomes)
+		{
+			outcomes[i] = copy_move_processed;
+		}
+		else if (!copy_move_report_file(task_id, source, out_files[i], copy_move_processed, verbose))
+		{
+			return 0;
+		}
 	}
 
 	return 1;
 }
 
-uint8_t copy_move_read_over_write(
-	void* task_arguments, uint8_t* over_write, uint8_t verbose)
+uint8_t copy_move_read_bool(
+	void* task_arguments, uint8_t position, uint8_t* output, uint8_t verbose)
 {
-	void* over_write_in_a_buffer = buffer_buffer_data(
-									   task_arguments, COPY_MOVE_OVER_WRITE);
-	const uint8_t size = (uint8_t)buffer_size(over_write_in_a_buffer);
+	void* bool_in_a_buffer = buffer_buffer_data(task_arguments, position);
+	const uint8_t size = (uint8_t)buffer_size(bool_in_a_buffer);
 
 	if (size)
 	{
-		const uint8_t* value = buffer_uint8_t_data(over_write_in_a_buffer, 0);
+		const uint8_t* value = buffer_uint8_t_data(bool_in_a_buffer, 0);
 
-		if (!bool_parse(value, value + size, over_write) ||
-			!buffer_resize(over_write_in_a_buffer, 0))
+		if (!bool_parse(value, value + size, output) ||
+			!buffer_resize(bool_in_a_buffer, 0))
 		{
 			return 0;
 		}
@@ -212,6 +358,7 @@ uint8_t copy_move_read_encodings(
 uint8_t copy_move_file_evaluate_task(
 	const struct range* source_file, uint8_t task_id,
 	uint16_t input_encoding, uint8_t output_encoding, uint8_t over_write,
+	uint8_t preserve_last_modified, const struct range* checksum, ptrdiff_t* counters,
 	void* task_arguments, uint8_t verbose)
 {
 	if (range_is_null_or_empty(source_file) ||
@@ -281,15 +428,197 @@ uint8_t copy_move_file_evaluate_task(
 	return copy_move_file(task_id, source_file->start,
 						  out_files, COUNT_OF(out_files),
 						  input_encoding, output_encoding,
-						  over_write, verbose);
+						  over_write, preserve_last_modified, checksum, counters, NULL, verbose);
+}
+
+struct copy_move_jobs
+{
+	uint8_t mutex[BUFFER_SIZE_OF];
+	const uint8_t** sources;
+	const uint8_t** destinations;
+	uint8_t* outcomes;
+	ptrdiff_t count;
+	ptrdiff_t next;
+	ptrdiff_t failed;
+	uint16_t input_encoding;
+	uint8_t output_encoding;
+	uint8_t task_id;
+	const struct range* checksum;
+	ptrdiff_t* counters;
+	uint8_t over_write;
+	uint8_t preserve_last_modified;
+	uint8_t verbose;
+};
+
+uint8_t copy_move_worker(void* argument)
+{
+	struct copy_move_jobs* jobs = (struct copy_move_jobs*)argument;
+	ptrdiff_t counters[2];
+	counters[0] = counters[1] = 0;
+
+	while (1)
+	{
+		thread_mutex_lock(jobs->mutex);
+		const ptrdiff_t i = jobs->next++;
+		/*NOTE: jobs after the first fail are skipped, so result not depend on order of the threads.*/
+		const uint8_t stop = jobs->count <= i || jobs->failed < i;
+		thread_mutex_unlock(jobs->mutex);
+
+		if (stop)
+		{
+			break;
+		}
+
+		if (!copy_move_file(
+				jobs->task_id, jobs->sources[i], &(jobs->destinations[i]), 1,
+				jobs->input_encoding, jobs->output_encoding,
+				jobs->over_write, jobs->preserve_last_modified,
+				jobs->checksum, counters, &(jobs->outcomes[i]), jobs->verbose))
+		{
+			thread_mutex_lock(jobs->mutex);
+			jobs->failed = MIN(jobs->failed, i);
+			thread_mutex_unlock(jobs->mutex);
+		}
+	}
+
+	if (NULL != jobs->counters)
+	{
+		thread_mutex_lock(jobs->mutex);
+		jobs->counters[0] += counters[0];
+		jobs->counters[1] += counters[1];
+		thread_mutex_unlock(jobs->mutex);
+	}
+
+	return 1;
+}
+
+uint8_t copy_move_add_job(void* jobs, const uint8_t* source, const void* destination)
+{
+	return buffer_append(jobs, (const uint8_t*)&source, sizeof(const uint8_t*)) &&
+		   buffer_append_data_from_buffer(jobs, destination);
+}
+
+uint8_t copy_move_run_jobs(
+	void* jobs_in_a_buffer, uint16_t threads, uint8_t task_id,
+	uint16_t input_encoding, uint8_t output_encoding,
+	uint8_t over_write, uint8_t preserve_last_modified,
+	const struct range* checksum, ptrdiff_t* counters, uint8_t verbose)
+{
+	const ptrdiff_t size = buffer_size(jobs_in_a_buffer);
+	ptrdiff_t count = 0;
+	ptrdiff_t position = 0;
+
+	while (position < size)
+	{
+		position += sizeof(const uint8_t*);
+		position += 1 + common_count_bytes_until(buffer_uint8_t_data(jobs_in_a_buffer, position), 0);
+		++count;
+	}
+
+	if (!count)
+	{
+		return 1;
+	}
+
+	const ptrdiff_t aligned_size = sizeof(const uint8_t*) * ((size + sizeof(const uint8_t*) - 1) / sizeof(
+									   const uint8_t*));
+
+	if (!buffer_append(jobs_in_a_buffer, NULL,
+					   aligned_size - size + 2 * count * sizeof(const uint8_t*) + count))
+	{
+		return 0;
+	}
+
+	struct copy_move_jobs jobs;
+	/**/
+	jobs.sources = (const uint8_t**)buffer_data(jobs_in_a_buffer, aligned_size);
+	jobs.destinations = jobs.sources + count;
+	jobs.outcomes = (uint8_t*)(jobs.destinations + count);
+	memset(jobs.outcomes, copy_move_not_processed, count);
+	jobs.count = count;
+	jobs.next = 0;
+	jobs.failed = count;
+	jobs.input_encoding = input_encoding;
+	jobs.output_encoding = output_encoding;
+	jobs.task_id = task_id;
+	jobs.over_write = over_write;
+	jobs.preserve_last_modified = preserve_last_modified;
+	jobs.checksum = checksum;
+	jobs.counters = counters;
+	jobs.verbose = verbose;
+	/**/
+	position = 0;
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		memcpy(&(jobs.sources[i]), buffer_data(jobs_in_a_buffer, position), sizeof(const uint8_t*));
+		position += sizeof(const uint8_t*);
+		jobs.destinations[i] = buffer_uint8_t_data(jobs_in_a_buffer, position);
+		position += 1 + common_count_bytes_until(jobs.destinations[i], 0);
+	}
+
+	if (!buffer_init(jobs.mutex, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	if (!thread_mutex_init(jobs.mutex))
+	{
+		thread_mutex_release(jobs.mutex);
+		return 0;
+	}
+
+	threads = (uint16_t)MIN(threads, count);
+	/*NOTE: workers do not touch the project, so other targets can be interpreted meanwhile.*/
+	thread_leave_interpreter();
+	thread_run(threads, copy_move_worker, &jobs);
+	thread_enter_interpreter();
+	/**/
+	thread_mutex_release(jobs.mutex);
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		if (!copy_move_report_file(task_id, jobs.sources[i], jobs.destinations[i], jobs.outcomes[i], verbose))
+		{
+			return 0;
+		}
+	}
+
+	return count == jobs.failed;
+}
+
+uint8_t copy_move_compile_exclude(const void* task_arguments, void* output)
+{
+	const void* exclude_in_a_buffer = buffer_buffer_data(task_arguments, COPY_MOVE_EXCLUDE);
+	const uint8_t* start = buffer_uint8_t_data(exclude_in_a_buffer, 0);
+	const uint8_t* finish = start + buffer_size(exclude_in_a_buffer);
+	static const uint8_t semicolon = ';';
+
+	while (start < finish)
+	{
+		const uint8_t* pos = string_find_any_symbol_like_or_not_like_that(
+								 start, finish, &semicolon, &semicolon + 1, 1, 1);
+
+		if (start < pos &&
+			!path_glob_compile(start, pos, output))
+		{
+			return 0;
+		}
+
+		start = pos + (pos < finish);
+	}
+
+	return 1;
 }
 
 uint8_t copy_move_dir_evaluate_task(
 	void* dir_in_a_buffer, uint8_t task_id,
 	uint16_t input_encoding, uint8_t output_encoding, uint8_t over_write,
-	void* task_arguments, uint8_t verbose)
+	uint8_t preserve_last_modified, const struct range* checksum, ptrdiff_t* counters,
+	const void* exclude, void* jobs, void* task_arguments, uint8_t verbose)
 {
 	if (NULL == dir_in_a_buffer ||
+		NULL == jobs ||
 		NULL == task_arguments)
 	{
 		return 0;
@@ -308,6 +637,16 @@ uint8_t copy_move_dir_evaluate_task(
 		}
 	}
 
+	const void* threads_in_a_buffer = buffer_buffer_data(task_arguments, COPY_MOVE_THREADS);
+	uint16_t threads = (uint16_t)buffer_size(threads_in_a_buffer);
+
+	if (threads)
+	{
+		const uint8_t* value = buffer_uint8_t_data(threads_in_a_buffer, 0);
+		const uint64_t count = uint64_parse(value, value + threads);
+		threads = (uint16_t)MIN(count, UINT16_MAX);
+	}
+
 	const ptrdiff_t dir_in_a_buffer_size = buffer_size(dir_in_a_buffer);
 #ifdef _WIN32
 	static const uint8_t* wild_card = (const uint8_t*)"*\0";
@@ -327,7 +666,7 @@ uint8_t copy_move_dir_evaluate_task(
 #endif
 
 	if (!buffer_resize(flatten_in_a_buffer, 0) ||
-		!directory_enumerate_file_system_entries(dir_in_a_buffer, 1, 1, flatten_in_a_buffer, 1))
+		!directory_enumerate_file_system_entries(dir_in_a_buffer, 1, 1, exclude, flatten_in_a_buffer, 1, threads))
 	{
 		return 0;
 	}
@@ -364,7 +703,7 @@ uint8_t copy_move_dir_evaluate_task(
 			if (!copy_move_file(
 					task_id, start, &file_name_start, 1,
 					input_encoding, output_encoding,
-					over_write, verbose))
+					over_write, preserve_last_modified, checksum, counters, NULL, verbose))
 			{
 				return 0;
 			}
@@ -420,10 +759,17 @@ uint8_t copy_move_dir_evaluate_task(
 		*ptr = delimiter;
 		start -= dir_in_a_buffer_size;
 
-		if (!copy_move_file(
-				task_id, start, &(directory_name.start), 1,
-				input_encoding, output_encoding,
-				over_write, verbose))
+		if (1 < threads)
+		{
+			if (!copy_move_add_job(jobs, start, to_dir_in_a_buffer))
+			{
+				return 0;
+			}
+		}
+		else if (!copy_move_file(
+					 task_id, start, &(directory_name.start), 1,
+					 input_encoding, output_encoding,
+					 over_write, preserve_last_modified, checksum, counters, NULL, verbose))
 		{
 			return 0;
 		}
@@ -436,6 +782,14 @@ uint8_t copy_move_dir_evaluate_task(
 		start = string_enumerate(pos, finish, NULL);
 	}
 
+	if (1 < threads &&
+		!copy_move_run_jobs(jobs, threads, task_id,
+							input_encoding, output_encoding, over_write, preserve_last_modified,
+							checksum, counters, verbose))
+	{
+		return 0;
+	}
+
 	void* include_empty_dirs_in_a_buffer = buffer_buffer_data(
 			task_arguments, COPY_MOVE_INCLUDE_EMPTY_DIRS);
 	uint8_t include_empty_dirs = (uint8_t)buffer_size(include_empty_dirs_in_a_buffer);
@@ -457,7 +811,7 @@ uint8_t copy_move_dir_evaluate_task(
 	if (include_empty_dirs)
 	{
 		if (!buffer_resize(flatten_in_a_buffer, 0) ||
-			!directory_enumerate_file_system_entries(dir_in_a_buffer, 0, 1, flatten_in_a_buffer, 1))
+			!directory_enumerate_file_system_entries(dir_in_a_buffer, 0, 1, exclude, flatten_in_a_buffer, 1, threads))
 		{
 			return 0;
 		}
@@ -502,6 +856,25 @@ uint8_t copy_move_dir_evaluate_task(
 	return 1;
 }
 
+uint8_t copy_move_report(const ptrdiff_t* counters, void* output, uint8_t verbose)
+{
+	static const uint8_t* copied = (const uint8_t*)"Copied ";
+	static const uint8_t* skipped = (const uint8_t*)" file(s), skipped ";
+	static const uint8_t* up_to_date = (const uint8_t*)" up-to-date file(s).";
+
+	if (!buffer_resize(output, 0) ||
+		!buffer_append(output, copied, 7) ||
+		!int64_to_string(counters[0], output) ||
+		!buffer_append(output, skipped, 18) ||
+		!int64_to_string(counters[1], output) ||
+		!buffer_append(output, up_to_date, 20))
+	{
+		return 0;
+	}
+
+	return echo(0, Default, NULL, Info, buffer_uint8_t_data(output, 0), buffer_size(output), 1, verbose);
+}
+
 uint8_t copy_move_evaluate_task(
 	const void* the_project, const void* the_target,
 	uint8_t task_id, void* task_arguments, uint8_t verbose)
@@ -521,12 +894,45 @@ uint8_t copy_move_evaluate_task(
 	}
 
 	uint8_t over_write = 0;
-
-	if (!copy_move_read_over_write(task_arguments, &over_write, verbose))
+	uint8_t preserve_last_modified = 0;
+	uint8_t skip_unchanged = 0;
+	const uint8_t is_over_write_set = 0 < buffer_size(buffer_buffer_data(task_arguments, COPY_MOVE_OVER_WRITE));
+
+	if (!copy_move_read_bool(task_arguments, COPY_MOVE_OVER_WRITE, &over_write, verbose) ||
+		!copy_move_read_bool(task_arguments, COPY_MOVE_PRESERVE_LAST_MODIFIED, &preserve_last_modified,
+							 verbose) ||
+		!copy_move_read_bool(task_arguments, COPY_MOVE_SKIP_UNCHANGED, &skip_unchanged, verbose))
 	{
 		return 0;
 	}
 
+	const void* checksum_in_a_buffer = buffer_buffer_data(task_arguments, COPY_MOVE_CHECKSUM);
+	struct range checksum_algorithm;
+
+	BUFFER_TO_RANGE(checksum_algorithm, checksum_in_a_buffer);
+	/*NOTE: destination is compared with the source only for the copy task.*/
+	skip_unchanged = file_system_copy_task == task_id &&
+					 (skip_unchanged || !range_is_null_or_empty(&checksum_algorithm));
+	const struct range* checksum = skip_unchanged ? &checksum_algorithm : NULL;
+
+	/*NOTE: changed destination is replaced, so explicit refuse to overwrite can not be combined with the compare.*/
+	if (skip_unchanged)
+	{
+		if (is_over_write_set &&
+			!over_write)
+		{
+			static const uint8_t* message =
+				(const uint8_t*)"Parameters 'skipunchanged' and 'checksum' can not be used with 'overwrite' set to false.";
+			echo(0, Default, NULL, Error, message, 88, 1, verbose);
+			return 0;
+		}
+
+		over_write = 1;
+	}
+
+	ptrdiff_t counters[2];
+	counters[0] = counters[1] = 0;
+
 	void* to_dir_in_a_buffer = buffer_buffer_data(task_arguments, COPY_MOVE_TO_DIR);
 	const ptrdiff_t to_dir_path_size = buffer_size(to_dir_in_a_buffer);
 
@@ -594,8 +1000,36 @@ uint8_t copy_move_evaluate_task(
 			return 1;
 		}
 
-		if (!copy_move_dir_evaluate_task(
-				dir_in_a_buffer, task_id, input_encoding, output_encoding, over_write, task_arguments, verbose))
+		uint8_t exclude_buffer[BUFFER_SIZE_OF];
+		void* exclude = (void*)exclude_buffer;
+
+		if (!buffer_init(exclude, BUFFER_SIZE_OF))
+		{
+			return 0;
+		}
+
+		if (!copy_move_compile_exclude(task_arguments, exclude))
+		{
+			buffer_release(exclude);
+			return 0;
+		}
+
+		uint8_t jobs_buffer[BUFFER_SIZE_OF];
+		void* jobs = (void*)jobs_buffer;
+
+		if (!buffer_init(jobs, BUFFER_SIZE_OF))
+		{
+			buffer_release(exclude);
+			return 0;
+		}
+
+		const uint8_t returned = copy_move_dir_evaluate_task(
+									 dir_in_a_buffer, task_id, input_encoding, output_encoding, over_write, preserve_last_modified,
+									 checksum, counters, buffer_size(exclude) ? exclude : NULL, jobs, task_arguments, verbose);
+		buffer_release(jobs);
+		buffer_release(exclude);
+
+		if (!returned)
 		{
 			return 0;
 		}
@@ -628,12 +1062,18 @@ uint8_t copy_move_evaluate_task(
 		BUFFER_TO_RANGE(source, file_in_a_buffer);
 
 		if (!copy_move_file_evaluate_task(
-				&source, task_id, input_encoding, output_encoding, over_write, task_arguments, verbose))
+				&source, task_id, input_encoding, output_encoding, over_write, preserve_last_modified, checksum, counters, task_arguments, verbose))
 		{
 			return 0;
 		}
 	}
 
+	if (skip_unchanged)
+	{
+		return copy_move_report(
+				   counters, buffer_buffer_data(task_arguments, COPY_MOVE_SKIP_UNCHANGED), verbose);
+	}
+
 	return 1;
 }
 
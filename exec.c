@@ -6,6 +6,9 @@
  */
 
 #if !defined(_WIN32)
+#if defined(__linux__)
+#define _GNU_SOURCE 1
+#endif
 #define _POSIX_SOURCE 1
 #define _POSIX_C_SOURCE 200112L
 #endif
@@ -14,14 +17,15 @@
 #include "argument_parser.h"
 #include "buffer.h"
 #include "common.h"
-#include "date_time.h"
 #include "echo.h"
 #include "file_system.h"
 #include "path.h"
+#include "project.h"
 #include "property.h"
 #include "range.h"
 #include "string_unit.h"
 #include "text_encoding.h"
+#include "thread.h"
 #include "xml.h"
 
 #include <stdio.h>
@@ -32,9 +36,20 @@
 #include <windows.h>
 #else
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 #include <sys/wait.h>
+
+#if defined(__GLIBC__) && (2 < __GLIBC__ || (2 == __GLIBC__ && 29 <= __GLIBC_MINOR__))
+#define EXEC_SPAWN_WITH_CHDIR 1
+#endif
+
+extern char** environ;
 #endif
 
 #if defined(_WIN32)
@@ -113,6 +128,102 @@ uint8_t exec_get_program_full_path(
 	return buffer_push_back(path_to_the_program, zero);
 }
 
+uint8_t exec_open_output(const uint8_t* file, uint8_t append, void** stream)
+{
+	if (NULL == stream)
+	{
+		return 0;
+	}
+
+	*stream = NULL;
+
+	if (NULL == file)
+	{
+		return 1;
+	}
+
+	if (!file_open(file, append ? (const uint8_t*)"ab" : (const uint8_t*)"wb", stream))
+	{
+		return 0;
+	}
+
+	/*NOTE: output is written once per read from the pipe, so larger buffer reduce count of system calls.*/
+	setvbuf((FILE*)(*stream), NULL, _IOFBF, 65536);
+	return 1;
+}
+
+uint8_t exec_write_output(
+	void* stream, void* content,
+	const uint8_t* data, ptrdiff_t size, uint8_t verbose)
+{
+	if (NULL != stream &&
+		size != (ptrdiff_t)file_write(data, sizeof(uint8_t), size, stream))
+	{
+		return 0;
+	}
+
+	if (NULL != content &&
+		!buffer_append(content, data, size))
+	{
+		return 0;
+	}
+
+	if (NULL == stream && NULL == content)
+	{
+		return echo(1, Default, NULL, Info, data, size, 0, verbose);
+	}
+
+	return 1;
+}
+
+uint8_t exec_set_property(
+	const void* the_project, const struct range* property_name,
+	const void* value, ptrdiff_t value_length, enum data_type type_of_value, uint8_t verbose)
+{
+	if (range_is_null_or_empty(property_name))
+	{
+		return 1;
+	}
+
+	/*NOTE: pointer to the property is not kept while interpreter is left,
+	  because other thread can change storage of the properties at that time.*/
+	void* the_property = NULL;
+
+	if (!project_property_exists(the_project, property_name->start,
+								 (uint8_t)range_size(property_name), &the_property, verbose))
+	{
+		return 0;
+	}
+
+	return property_set_by_pointer(the_property, value, value_length, type_of_value, 0, 0, verbose);
+}
+
+uint8_t exec_close_output(
+	const void* the_project, void* stream, void* content,
+	const struct range* property_name, uint8_t verbose)
+{
+	uint8_t result = 1;
+
+	if (NULL != stream)
+	{
+		result = file_close(stream);
+	}
+
+	if (NULL != content)
+	{
+		if (NULL != property_name)
+		{
+			result = exec_set_property(
+						 the_project, property_name, buffer_data(content, 0), buffer_size(content),
+						 property_value_is_byte_array, verbose) && result;
+		}
+
+		buffer_release(content);
+	}
+
+	return result;
+}
+
 #if defined(_WIN32)
 
 uint8_t exec_win32_append_command_line(
@@ -179,10 +290,68 @@ uint8_t exec_win32_append_command_line(
 	return buffer_push_back(output, zero);
 }
 
+static uint8_t processes_buffer[BUFFER_SIZE_OF];
+static uint8_t is_processes_init = 0;
+
+struct exec_process
+{
+	DWORD id;
+	HANDLE handle;
+};
+
+uint8_t exec_win32_register_process(DWORD id, HANDLE handle)
+{
+	void* processes = (void*)processes_buffer;
+
+	if (!is_processes_init)
+	{
+		if (!buffer_init(processes, BUFFER_SIZE_OF))
+		{
+			return 0;
+		}
+
+		is_processes_init = 1;
+	}
+
+	struct exec_process process;
+	process.id = id;
+	process.handle = handle;
+	/**/
+	return buffer_append(processes, (const uint8_t*)&process, sizeof(struct exec_process));
+}
+
+HANDLE exec_win32_take_process(DWORD id)
+{
+	if (is_processes_init)
+	{
+		void* processes = (void*)processes_buffer;
+		struct exec_process* process;
+		ptrdiff_t i = 0;
+
+		while (NULL != (process = (struct exec_process*)buffer_data(
+									  processes, i * sizeof(struct exec_process))))
+		{
+			if (id == process->id)
+			{
+				struct exec_process* last = (struct exec_process*)buffer_data(
+												processes, buffer_size(processes) - sizeof(struct exec_process));
+				const HANDLE handle = process->handle;
+				*process = *last;
+				buffer_resize(processes, buffer_size(processes) - sizeof(struct exec_process));
+				return handle;
+			}
+
+			++i;
+		}
+	}
+
+	return OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, id);
+}
+
 uint8_t exec_win32(const wchar_t* program, wchar_t* cmd,
 				   wchar_t* env, const wchar_t* working_dir,
-				   HANDLE std_output, HANDLE std_error,
-				   void* pid_property, HANDLE* process_handle,
+				   HANDLE std_output, HANDLE std_error, HANDLE job,
+				   const void* the_project, const struct range* pid_property, HANDLE* process_handle,
 				   uint8_t spawn, uint8_t verbose)
 {
 	if (NULL == program)
@@ -209,7 +378,7 @@ uint8_t exec_win32(const wchar_t* program, wchar_t* cmd,
 						NULL,
 						NULL,
 						TRUE,
-						NORMAL_PRIORITY_CLASS | CREATE_UNICODE_ENVIRONMENT,
+						NORMAL_PRIORITY_CLASS | CREATE_UNICODE_ENVIRONMENT | (NULL == job ? 0 : CREATE_SUSPENDED),
 						env,
 						working_dir,
 						&start_up_info,
@@ -218,17 +387,40 @@ uint8_t exec_win32(const wchar_t* program, wchar_t* cmd,
 		return 0;
 	}
 
+	if (NULL != job)
+	{
+		/*NOTE: process is added to the job before it can start others, so all of them can be terminated.
+		  If that is not possible, for example at old version of the system where process already in the job,
+		  only the process itself will be terminated.*/
+		AssignProcessToJobObject(job, process_information.hProcess);
+
+		if ((DWORD) -1 == ResumeThread(process_information.hThread))
+		{
+			TerminateProcess(process_information.hProcess, 1);
+			CloseHandle(process_information.hProcess);
+			CloseHandle(process_information.hThread);
+			return 0;
+		}
+	}
+
 	if (spawn &&
-		NULL != pid_property &&
-		!property_set_by_pointer(pid_property, &process_information.dwProcessId, sizeof(HANDLE),
-								 property_value_is_integer, 0, 0, verbose))
+		!exec_set_property(the_project, pid_property, &process_information.dwProcessId, sizeof(DWORD),
+						   property_value_is_integer, verbose))
 	{
 		CloseHandle(process_information.hProcess);
 		CloseHandle(process_information.hThread);
 		return 0;
 	}
 
-	if (NULL == process_handle)
+	if (spawn && NULL == process_handle)
+	{
+		/*NOTE: handle kept for the wait task, so exit code can be received.*/
+		if (!exec_win32_register_process(process_information.dwProcessId, process_information.hProcess))
+		{
+			CloseHandle(process_information.hProcess);
+		}
+	}
+	else if (NULL == process_handle)
 	{
 		CloseHandle(process_information.hProcess);
 	}
@@ -241,10 +433,21 @@ uint8_t exec_win32(const wchar_t* program, wchar_t* cmd,
 	return 1;
 }
 
+void exec_win32_terminate(HANDLE job, HANDLE process_handle)
+{
+	if (NULL != job)
+	{
+		TerminateJobObject(job, 1);
+	}
+
+	TerminateProcess(process_handle, 1);
+}
+
 uint8_t exec_win32_with_redirect(
 	const wchar_t* program, wchar_t* cmd, wchar_t* env, const wchar_t* working_dir,
-	void* pid_property, void* result_property, const uint8_t* file, void* tmp,
-	uint32_t time_out, uint8_t verbose)
+	const void* the_project, const struct range* result_property,
+	void* output_stream, void* output_content,
+	void* tmp, uint32_t time_out, uint8_t verbose)
 {
 	if (NULL == tmp)
 	{
@@ -265,15 +468,23 @@ uint8_t exec_win32_with_redirect(
 		return 0;
 	}
 
+	/*NOTE: with time out program run inside of the job, so processes started by it are terminated too.*/
+	HANDLE job = 0 < time_out ? CreateJobObjectW(NULL, NULL) : NULL;
 	HANDLE process_handle = INVALID_HANDLE_VALUE;
-	const int64_t time_span_start = 10 < time_out ? timespan_from_seconds((double)datetime_now()) : time_out;
+	const ULONGLONG time_span_start = GetTickCount64();
 
 	if (!exec_win32(
-			program, cmd, env, working_dir, hWritePipe, hWritePipe,
-			pid_property, result_property ? &process_handle : NULL, 0, verbose))
+			program, cmd, env, working_dir, hWritePipe, hWritePipe, job, the_project, NULL,
+			(!range_is_null_or_empty(result_property) || 0 < time_out) ? &process_handle : NULL, 0, verbose))
 	{
 		CloseHandle(hWritePipe);
 		CloseHandle(hReadPipe);
+
+		if (NULL != job)
+		{
+			CloseHandle(job);
+		}
+
 		return 0;
 	}
 
@@ -281,61 +492,205 @@ uint8_t exec_win32_with_redirect(
 
 	if (!buffer_resize(tmp, 4096))
 	{
+		exec_win32_terminate(job, process_handle);
+		CloseHandle(process_handle);
 		CloseHandle(hReadPipe);
+
+		if (NULL != job)
+		{
+			CloseHandle(job);
+		}
+
 		return 0;
 	}
 
-	security_attributes.nLength = (DWORD)(buffer_size(tmp) - 1);
-	security_attributes.lpSecurityDescriptor = buffer_data(tmp, 0);
+	uint8_t* data = buffer_uint8_t_data(tmp, 0);
+	const DWORD data_size = (DWORD)(buffer_size(tmp) - 1);
 	DWORD numberOfBytesRead = 0;
+	uint8_t is_timed_out = 0;
+	uint8_t result = 1;
 
-	while (ReadFile(hReadPipe,
-					security_attributes.lpSecurityDescriptor,
-					security_attributes.nLength,
-					&numberOfBytesRead, 0) &&
-		   0 < numberOfBytesRead)
+	while (1)
 	{
-		if (!echo(1, Default, file, Info, (const uint8_t*)(security_attributes.lpSecurityDescriptor),
-				  numberOfBytesRead, 0, verbose))
+		DWORD to_read = data_size;
+
+		if (0 < time_out)
 		{
-			CloseHandle(hReadPipe);
-			return 0;
+			/*NOTE: pipe is read only when data available, so time out is checked while program is silent.
+			  Pipe is broken when all processes that can write into it are finished.*/
+			DWORD available = 0;
+
+			if (!PeekNamedPipe(hReadPipe, NULL, 0, NULL, &available, NULL))
+			{
+				break;
+			}
+
+			if (!available)
+			{
+				/*NOTE: after termination output that was left is read, pipe still can be kept by the process
+				  that was not added to the job, so reading is not continued after that.*/
+				if (is_timed_out)
+				{
+					break;
+				}
+
+				if (time_out <= GetTickCount64() - time_span_start)
+				{
+					exec_win32_terminate(job, process_handle);
+					is_timed_out = 1;
+					continue;
+				}
+
+				thread_leave_interpreter();
+				Sleep(10);
+				thread_enter_interpreter();
+				continue;
+			}
+
+			to_read = MIN(available, data_size);
+		}
+
+		thread_leave_interpreter();
+		const BOOL is_read = ReadFile(hReadPipe, data, to_read, &numberOfBytesRead, 0);
+		thread_enter_interpreter();
+
+		if (!is_read || 0 == numberOfBytesRead)
+		{
+			break;
+		}
+
+		if (!exec_write_output(output_stream, output_content, data, numberOfBytesRead, verbose))
+		{
+			result = 0;
+			break;
 		}
 	}
 
 	CloseHandle(hReadPipe);
-	numberOfBytesRead = 1;
 
-	if (result_property)
+	if (INVALID_HANDLE_VALUE != process_handle)
 	{
-		numberOfBytesRead = (WAIT_FAILED != WaitForSingleObject(process_handle, INFINITE));
+		DWORD wait_time = INFINITE;
 
-		if (!numberOfBytesRead)
+		if (!result)
 		{
-			CloseHandle(process_handle);
-			return 0;
+			exec_win32_terminate(job, process_handle);
+		}
+		else if (0 < time_out)
+		{
+			const ULONGLONG elapsed = GetTickCount64() - time_span_start;
+			wait_time = elapsed < time_out ? (DWORD)(time_out - elapsed) : 0;
+		}
+
+		thread_leave_interpreter();
+		DWORD waited = WaitForSingleObject(process_handle, wait_time);
+
+		if (WAIT_TIMEOUT == waited)
+		{
+			exec_win32_terminate(job, process_handle);
+			is_timed_out = 1;
+			waited = WaitForSingleObject(process_handle, INFINITE);
+		}
+
+		thread_enter_interpreter();
+		DWORD exit_code = (DWORD) -1;
+
+		if (WAIT_FAILED == waited ||
+			(!is_timed_out && !GetExitCodeProcess(process_handle, &exit_code)))
+		{
+			result = 0;
 		}
 
-		security_attributes.nLength = 0;
-		numberOfBytesRead = (0 != GetExitCodeProcess(process_handle, &security_attributes.nLength));
 		CloseHandle(process_handle);
 
-		if (numberOfBytesRead &&
-			!property_set_by_pointer(result_property,
-									 (const void*)&security_attributes.nLength, sizeof(DWORD),
-									 property_value_is_integer, 0, 0, verbose))
+		if (result &&
+			!exec_set_property(the_project, result_property,
+							   (const void*)&exit_code, sizeof(DWORD),
+							   property_value_is_integer, verbose))
+		{
+			result = 0;
+		}
+	}
+
+	if (NULL != job)
+	{
+		CloseHandle(job);
+	}
+
+	return result && !is_timed_out;
+}
+
+uint8_t exec_wait(
+	const void* the_project, void* pids, uint32_t time_out,
+	const struct range* result_property, uint8_t verbose)
+{
+	const ptrdiff_t count = buffer_size(pids) / sizeof(int64_t);
+
+	if (count < 1)
+	{
+		return 0;
+	}
+
+	const ULONGLONG time_span_start = GetTickCount64();
+	const int64_t* ids = (const int64_t*)buffer_data(pids, 0);
+	DWORD status = 0;
+	uint8_t is_timed_out = 0;
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		const HANDLE process_handle = exec_win32_take_process((DWORD)ids[i]);
+
+		if (NULL == process_handle)
 		{
 			return 0;
 		}
+
+		DWORD wait_time = INFINITE;
+
+		if (0 < time_out)
+		{
+			const ULONGLONG elapsed = GetTickCount64() - time_span_start;
+			wait_time = elapsed < time_out ? (DWORD)(time_out - elapsed) : 0;
+		}
+
+		thread_leave_interpreter();
+		const DWORD waited = WaitForSingleObject(process_handle, wait_time);
+		thread_enter_interpreter();
+
+		if (WAIT_TIMEOUT == waited)
+		{
+			/*NOTE: process still can be waited later.*/
+			if (!exec_win32_register_process((DWORD)ids[i], process_handle))
+			{
+				CloseHandle(process_handle);
+			}
+
+			is_timed_out = 1;
+			status = (DWORD)(-1);
+			break;
+		}
+
+		DWORD code = 0;
+
+		if (WAIT_FAILED == waited ||
+			!GetExitCodeProcess(process_handle, &code))
+		{
+			CloseHandle(process_handle);
+			return 0;
+		}
+
+		CloseHandle(process_handle);
+		status = 0 == status ? code : status;
 	}
 
-	if (!numberOfBytesRead)
+	if (!exec_set_property(
+			the_project, result_property, (const void*)&status, sizeof(DWORD),
+			property_value_is_integer, verbose))
 	{
 		return 0;
 	}
 
-	const int64_t time_span_finish = 10 < time_out ? timespan_from_seconds((double)datetime_now()) : time_out;
-	return time_span_start < time_span_finish ? time_span_finish - time_span_start <= time_out : 1;
+	return !is_timed_out;
 }
 
 uint8_t exec(
@@ -346,8 +701,11 @@ uint8_t exec(
 	const struct range* base_dir,
 	const struct range* command_line,
 	const struct range* output_file,
-	void* pid_property,
-	void* result_property,
+	const struct range* output_property,
+	const struct range* error_file,
+	const struct range* error_property,
+	const struct range* pid_property,
+	const struct range* result_property,
 	const struct range* working_dir,
 	const struct range* environment_variables,
 	uint8_t spawn,
@@ -361,12 +719,12 @@ uint8_t exec(
 
 	const uint8_t* file = range_is_null_or_empty(output_file) ? NULL : output_file->start;
 
-	if (!spawn && !append && NULL != file)
+	/*TODO: capture of the error output not yet implemented at Windows, it is merged with the output.*/
+	if ((!range_is_null_or_empty(error_file) || !range_is_null_or_empty(error_property)) &&
+		!echo(0, Default, NULL, Warning,
+			  (const uint8_t*)"Capture of the error output not yet supported at Windows, it will be merged with the output.", 92, 1, 0))
 	{
-		if (!echo(0, Default, file, Info, NULL, 0, 1, verbose))
-		{
-			return 0;
-		}
+		return 0;
 	}
 
 	struct range program_in_the_range;
@@ -525,12 +883,35 @@ uint8_t exec(
 	if (spawn)
 	{
 		spawn = exec_win32(programW, command_lineW, environment_variablesW, working_dirW,
-						   NULL, NULL, pid_property, NULL, spawn, verbose);
+						   NULL, NULL, NULL, the_project, pid_property, NULL, spawn, verbose);
 	}
 	else
 	{
+		uint8_t content_buffer[BUFFER_SIZE_OF];
+		void* content = NULL;
+		void* stream = NULL;
+
+		if (!range_is_null_or_empty(output_property))
+		{
+			content = (void*)content_buffer;
+
+			if (!buffer_init(content, BUFFER_SIZE_OF))
+			{
+				buffer_release(application);
+				return 0;
+			}
+		}
+
+		if (!exec_open_output(file, append, &stream))
+		{
+			exec_close_output(the_project, NULL, content, NULL, verbose);
+			buffer_release(application);
+			return 0;
+		}
+
 		spawn = exec_win32_with_redirect(programW, command_lineW, environment_variablesW, working_dirW,
-										 pid_property, result_property, file, application, time_out, verbose);
+										 the_project, result_property, stream, content, application, time_out, verbose);
+		spawn = exec_close_output(the_project, stream, content, output_property, verbose) && spawn;
 	}
 
 	buffer_release(application);
@@ -539,126 +920,301 @@ uint8_t exec(
 
 #else
 
-uint8_t exec_posix_no_redirect(
+uint8_t exec_posix_spawn(
 	const char* program, char** cmd, char** env, const char* working_dir,
-	void* pid_property, void* result_property, uint8_t verbose)
+	int output, int error, uint8_t new_group, pid_t* pid)
 {
 	if (NULL == program ||
 		NULL == cmd ||
-		NULL == pid_property)
+		NULL == pid)
 	{
 		return 0;
 	}
 
-	const pid_t pid = fork();
+	env = NULL == env ? environ : env;
+#if defined(EXEC_SPAWN_WITH_CHDIR)
+	const uint8_t use_spawn = 1;
+#else
+	const uint8_t use_spawn = NULL == working_dir;
+#endif
 
-	if (!property_set_by_pointer(
-			pid_property, (const void*)&pid, sizeof(pid_t), property_value_is_integer, 0, 0, verbose))
+	if (use_spawn)
 	{
-		return 0;
+		posix_spawn_file_actions_t actions;
+		posix_spawnattr_t attributes;
+
+		if (0 != posix_spawn_file_actions_init(&actions))
+		{
+			return 0;
+		}
+
+		if (0 != posix_spawnattr_init(&attributes))
+		{
+			posix_spawn_file_actions_destroy(&actions);
+			return 0;
+		}
+
+		int status = 0;
+
+		if (-1 != output)
+		{
+			status = posix_spawn_file_actions_adddup2(&actions, output, STDOUT_FILENO);
+		}
+
+		if (0 == status && -1 != error)
+		{
+			status = posix_spawn_file_actions_adddup2(&actions, error, STDERR_FILENO);
+		}
+
+#if defined(EXEC_SPAWN_WITH_CHDIR)
+
+		if (0 == status && NULL != working_dir)
+		{
+			status = posix_spawn_file_actions_addchdir_np(&actions, working_dir);
+		}
+
+#endif
+
+		if (0 == status && new_group)
+		{
+			status = posix_spawnattr_setpgroup(&attributes, 0);
+
+			if (0 == status)
+			{
+				status = posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+			}
+		}
+
+		if (0 == status)
+		{
+			status = posix_spawn(pid, program, &actions, &attributes, cmd, env);
+		}
+
+		posix_spawnattr_destroy(&attributes);
+		posix_spawn_file_actions_destroy(&actions);
+		return 0 == status;
 	}
 
-	if (-1 == pid)
+	*pid = fork();
+
+	if (-1 == *pid)
 	{
 		return 0;
 	}
-	else if (0 == pid)
+	else if (0 == *pid)
 	{
-		if (NULL != working_dir && -1 == chdir(working_dir))
+		if (new_group)
 		{
-			exit(EXIT_FAILURE);
+			setpgid(0, 0);
 		}
 
-		int status = EXIT_SUCCESS;
-
-		if (NULL == env)
+		if (-1 != output)
 		{
-			status = execv(program, cmd);
+			while ((dup2(output, STDOUT_FILENO) == -1) && (errno == EINTR)) {}
 		}
-		else
+
+		if (-1 != error)
 		{
-			status = execve(program, cmd, env);
+			while ((dup2(error, STDERR_FILENO) == -1) && (errno == EINTR)) {}
 		}
 
-		if (NULL != result_property)
+		if (NULL != working_dir && -1 == chdir(working_dir))
 		{
-			property_set_by_pointer(result_property, (const void*)&status, sizeof(status),
-									property_value_is_integer, 0, 0, verbose);
+			_exit(EXIT_FAILURE);
 		}
 
-		exit(status);
+		execve(program, cmd, env);
+		_exit(EXIT_FAILURE);
+	}
+
+	if (new_group)
+	{
+		setpgid(*pid, *pid);
 	}
 
 	return 1;
 }
 
-uint8_t exec_posix_with_redirect(
+uint8_t exec_posix_no_redirect(
 	const char* program, char** cmd, char** env, const char* working_dir,
-	const uint8_t* file, void* tmp, uint32_t time_out, void* result_property, uint8_t verbose)
+	const void* the_project, const struct range* pid_property, uint8_t verbose)
 {
-	if (NULL == program ||
-		NULL == cmd ||
-		NULL == tmp)
+	if (range_is_null_or_empty(pid_property))
 	{
 		return 0;
 	}
 
-	int file_des[2];
-	const int64_t time_span_start = 10 < time_out ? timespan_from_seconds((double)datetime_now()) : time_out;
+	pid_t pid = -1;
+	const uint8_t is_spawned = exec_posix_spawn(program, cmd, env, working_dir, -1, -1, 0, &pid);
+	return exec_set_property(
+			   the_project, pid_property, (const void*)&pid, sizeof(pid_t), property_value_is_integer, verbose) &&
+		   is_spawned;
+}
 
-	if (pipe(file_des) == -1)
+int64_t exec_posix_get_monotonic_milliseconds()
+{
+	struct timespec now;
+
+	if (-1 == clock_gettime(CLOCK_MONOTONIC, &now))
 	{
-		return 0;
+		return -1;
 	}
 
-	const pid_t pid = fork();
+	return 1000 * (int64_t)now.tv_sec + now.tv_nsec / 1000000;
+}
 
-	if (-1 == pid)
+int exec_posix_get_poll_time_out(int64_t dead_line, int current_interval)
+{
+	if (dead_line < 0)
+	{
+		return current_interval;
+	}
+
+	const int64_t now = exec_posix_get_monotonic_milliseconds();
+
+	if (now < 0 || dead_line <= now)
 	{
-		close(file_des[1]);
-		close(file_des[0]);
 		return 0;
 	}
-	else if (0 == pid)
+
+	return (int)MIN(dead_line - now, (int64_t)current_interval);
+}
+
+int exec_posix_get_exit_code(int status)
+{
+	if (WIFEXITED(status))
 	{
-		while ((dup2(file_des[1], STDOUT_FILENO) == -1) && (errno == EINTR)) {}
+		return WEXITSTATUS(status);
+	}
+	else if (WIFSIGNALED(status))
+	{
+		return 128 + WTERMSIG(status);
+	}
 
-		close(file_des[1]);
-		close(file_des[0]);
+	return status;
+}
 
-		if (NULL != working_dir && -1 == chdir(working_dir))
+void exec_posix_close_pipes(int file_des[][2], uint8_t count)
+{
+	for (uint8_t i = 0; i < count; ++i)
+	{
+		for (uint8_t j = 0; j < 2; ++j)
 		{
-			exit(EXIT_FAILURE);
+			if (-1 != file_des[i][j])
+			{
+				close(file_des[i][j]);
+				file_des[i][j] = -1;
+			}
 		}
+	}
+}
+
+uint8_t exec_posix_stop(pid_t pid, int file_des[][2], uint8_t count)
+{
+	exec_posix_close_pipes(file_des, count);
+	kill(-pid, SIGKILL);
+	thread_leave_interpreter();
+
+	while (-1 == waitpid(pid, NULL, 0) && EINTR == errno) {}
+
+	thread_enter_interpreter();
+	return 0;
+}
+
+uint8_t exec_posix_wait(
+	const char* program, char** cmd, char** env, const char* working_dir,
+	void** streams, void** contents, uint8_t streams_count,
+	void* tmp, uint32_t time_out, int* status, uint8_t* is_timed_out, uint8_t verbose)
+{
+	if (NULL == program ||
+		NULL == cmd ||
+		NULL == streams ||
+		NULL == contents ||
+		streams_count < 1 ||
+		2 < streams_count ||
+		NULL == tmp ||
+		NULL == status ||
+		NULL == is_timed_out)
+	{
+		return 0;
+	}
 
-		int status = EXIT_SUCCESS;
+	int64_t dead_line = -1;
 
-		if (NULL == env)
+	if (0 < time_out)
+	{
+		dead_line = exec_posix_get_monotonic_milliseconds();
+
+		if (dead_line < 0)
 		{
-			status = execv(program, cmd);
+			return 0;
 		}
-		else
+
+		dead_line += time_out;
+	}
+
+	int file_des[2][2] = { { -1, -1 }, { -1, -1 } };
+
+	for (uint8_t i = 0; i < streams_count; ++i)
+	{
+		if (pipe(file_des[i]) == -1)
 		{
-			status = execve(program, cmd, env);
+			exec_posix_close_pipes(file_des, streams_count);
+			return 0;
 		}
 
-		exit(status);
+		/*NOTE: ends of the pipe should not leak into programs started by other threads.*/
+		fcntl(file_des[i][0], F_SETFD, FD_CLOEXEC);
+		fcntl(file_des[i][1], F_SETFD, FD_CLOEXEC);
 	}
 
-	close(file_des[1]);
+	pid_t pid = -1;
 
-	if (!buffer_resize(tmp, 4096))
+	/*NOTE: own process group, so on time out whole tree of the program can be stopped.*/
+	if (!exec_posix_spawn(program, cmd, env, working_dir,
+						  file_des[0][1], 1 < streams_count ? file_des[1][1] : -1, 1, &pid))
 	{
-		close(file_des[0]);
+		exec_posix_close_pipes(file_des, streams_count);
 		return 0;
 	}
 
+	struct pollfd poll_fds[2];
+	uint8_t opened = streams_count;
+
+	for (uint8_t i = 0; i < streams_count; ++i)
+	{
+		close(file_des[i][1]);
+		file_des[i][1] = -1;
+		/**/
+		poll_fds[i].fd = file_des[i][0];
+		poll_fds[i].events = POLLIN;
+	}
+
+	if (!buffer_resize(tmp, 65536))
+	{
+		return exec_posix_stop(pid, file_des, streams_count);
+	}
+
 	uint8_t* ptr = buffer_uint8_t_data(tmp, 0);
-	const ptrdiff_t size = buffer_size(tmp) - 1;
+	const ptrdiff_t size = buffer_size(tmp);
 	ssize_t count = 0;
+	*is_timed_out = 0;
 
-	while (0 != (count = read(file_des[0], ptr, size)))
+	while (0 < opened)
 	{
+		const int milliseconds = exec_posix_get_poll_time_out(dead_line, INT32_MAX);
+
+		if (0 == milliseconds)
+		{
+			*is_timed_out = 1;
+			break;
+		}
+
+		poll_fds[0].revents = poll_fds[1].revents = 0;
+		thread_leave_interpreter();
+		count = poll(poll_fds, streams_count, milliseconds);
+		thread_enter_interpreter();
+
 		if (-1 == count)
 		{
 			if (EINTR == errno)
@@ -666,34 +1222,248 @@ uint8_t exec_posix_with_redirect(
 				continue;
 			}
 
-			close(file_des[0]);
-			return 0;
+			return exec_posix_stop(pid, file_des, streams_count);
 		}
 
-		if (!echo(1, Default, file, Info, ptr, count, 0, verbose))
+		for (uint8_t i = 0; 0 < count && i < streams_count; ++i)
 		{
-			close(file_des[0]);
-			return 0;
+			if (!poll_fds[i].revents)
+			{
+				continue;
+			}
+
+			thread_leave_interpreter();
+			const ssize_t was_read = read(poll_fds[i].fd, ptr, size);
+			thread_enter_interpreter();
+
+			if (0 == was_read)
+			{
+				close(file_des[i][0]);
+				file_des[i][0] = poll_fds[i].fd = -1;
+				--opened;
+				continue;
+			}
+
+			if (-1 == was_read)
+			{
+				if (EINTR == errno ||
+					EAGAIN == errno)
+				{
+					continue;
+				}
+
+				return exec_posix_stop(pid, file_des, streams_count);
+			}
+
+			if (!exec_write_output(streams[i], contents[i], ptr, was_read, verbose))
+			{
+				return exec_posix_stop(pid, file_des, streams_count);
+			}
+		}
+	}
+
+	exec_posix_close_pipes(file_des, streams_count);
+	/*NOTE: output closed, but program still can work, so wait it with increasing interval.*/
+	int interval = 1;
+	pid_t waited = 0;
+
+	while (!(*is_timed_out))
+	{
+		waited = waitpid(pid, status, WNOHANG);
+
+		if (0 != waited)
+		{
+			if (-1 == waited && EINTR == errno)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		const int milliseconds = exec_posix_get_poll_time_out(dead_line, interval);
+
+		if (0 == milliseconds)
+		{
+			*is_timed_out = 1;
+			break;
+		}
+
+		thread_leave_interpreter();
+		poll(NULL, 0, milliseconds);
+		thread_enter_interpreter();
+		interval = MIN(2 * interval, 100);
+	}
+
+	if (*is_timed_out)
+	{
+		exec_posix_stop(pid, file_des, streams_count);
+		*status = -1;
+	}
+	else if (-1 == waited)
+	{
+		return 0;
+	}
+	else
+	{
+		*status = exec_posix_get_exit_code(*status);
+	}
+
+	return 1;
+}
+
+uint8_t exec_posix_with_redirect(
+	const char* program, char** cmd, char** env, const char* working_dir,
+	const void* the_project, uint8_t append,
+	const uint8_t* file, const struct range* output_property,
+	const uint8_t* error_file, const struct range* error_property,
+	void* tmp, uint32_t time_out, const struct range* result_property, uint8_t verbose)
+{
+	uint8_t content_buffers[2][BUFFER_SIZE_OF];
+	void* contents[2] = { NULL, NULL };
+	void* streams[2] = { NULL, NULL };
+	const struct range* properties[2] = { output_property, error_property };
+	const uint8_t* files[2] = { file, error_file };
+	const uint8_t streams_count = (NULL != error_file || !range_is_null_or_empty(error_property)) ? 2 : 1;
+	uint8_t result = 1;
+
+	for (uint8_t i = 0; result && i < streams_count; ++i)
+	{
+		if (!range_is_null_or_empty(properties[i]))
+		{
+			contents[i] = (void*)content_buffers[i];
+
+			if (!buffer_init(contents[i], BUFFER_SIZE_OF))
+			{
+				contents[i] = NULL;
+				result = 0;
+				break;
+			}
 		}
+
+		result = exec_open_output(files[i], append, &streams[i]);
 	}
 
-	close(file_des[0]);
-	count = 0;
+	int status = 0;
+	uint8_t is_timed_out = 0;
 
-	if (-1 == wait((int*)&count))
+	if (result)
+	{
+		result = exec_posix_wait(program, cmd, env, working_dir,
+								 streams, contents, streams_count,
+								 tmp, time_out, &status, &is_timed_out, verbose);
+	}
+
+	for (uint8_t i = 0; i < streams_count; ++i)
+	{
+		result = exec_close_output(
+					 the_project, streams[i], contents[i], result ? properties[i] : NULL, verbose) && result;
+	}
+
+	if (!result)
 	{
 		return 0;
 	}
 
-	if (NULL != result_property)
+	if (!exec_set_property(
+			the_project, result_property, (const void*)&status, sizeof(int),
+			property_value_is_integer, verbose))
 	{
-		return property_set_by_pointer(
-				   result_property, (const void*)&count, sizeof(int),
-				   property_value_is_integer, 0, 0, verbose);
+		return 0;
 	}
 
-	const int64_t time_span_finish = 10 < time_out ? timespan_from_seconds((double)datetime_now()) : time_out;
-	return time_span_start < time_span_finish ? time_span_finish - time_span_start <= time_out : 1;
+	return !is_timed_out;
+}
+
+uint8_t exec_wait(
+	const void* the_project, void* pids, uint32_t time_out,
+	const struct range* result_property, uint8_t verbose)
+{
+	ptrdiff_t pending = buffer_size(pids) / sizeof(int64_t);
+
+	if (pending < 1)
+	{
+		return 0;
+	}
+
+	int64_t dead_line = -1;
+
+	if (0 < time_out)
+	{
+		dead_line = exec_posix_get_monotonic_milliseconds();
+
+		if (dead_line < 0)
+		{
+			return 0;
+		}
+
+		dead_line += time_out;
+	}
+
+	int64_t* ids = (int64_t*)buffer_data(pids, 0);
+	const ptrdiff_t count = pending;
+	int status = 0;
+	int interval = 1;
+	uint8_t is_timed_out = 0;
+
+	while (0 < pending)
+	{
+		for (ptrdiff_t i = 0; i < count; ++i)
+		{
+			if (ids[i] < 1)
+			{
+				continue;
+			}
+
+			int code = 0;
+			const pid_t waited = waitpid((pid_t)ids[i], &code, WNOHANG);
+
+			if (0 == waited ||
+				(-1 == waited && EINTR == errno))
+			{
+				continue;
+			}
+
+			if (-1 == waited)
+			{
+				return 0;
+			}
+
+			code = exec_posix_get_exit_code(code);
+			status = 0 == status ? code : status;
+			/**/
+			ids[i] = 0;
+			--pending;
+		}
+
+		if (!pending)
+		{
+			break;
+		}
+
+		const int milliseconds = exec_posix_get_poll_time_out(dead_line, interval);
+
+		if (0 == milliseconds)
+		{
+			is_timed_out = 1;
+			status = -1;
+			break;
+		}
+
+		thread_leave_interpreter();
+		poll(NULL, 0, milliseconds);
+		thread_enter_interpreter();
+		interval = MIN(2 * interval, 100);
+	}
+
+	if (!exec_set_property(
+			the_project, result_property, (const void*)&status, sizeof(int),
+			property_value_is_integer, verbose))
+	{
+		return 0;
+	}
+
+	return !is_timed_out;
 }
 
 uint8_t exec(
@@ -704,8 +1474,11 @@ uint8_t exec(
 	const struct range* base_dir,
 	const struct range* command_line,
 	const struct range* output_file,
-	void* pid_property,
-	void* result_property,
+	const struct range* output_property,
+	const struct range* error_file,
+	const struct range* error_property,
+	const struct range* pid_property,
+	const struct range* result_property,
 	const struct range* working_dir,
 	const struct range* environment_variables,
 	uint8_t spawn,
@@ -718,14 +1491,7 @@ uint8_t exec(
 	}
 
 	const uint8_t* file = range_is_null_or_empty(output_file) ? NULL : output_file->start;
-
-	if (!spawn && !append && NULL != file)
-	{
-		if (!echo(0, Default, file, Info, NULL, 0, 1, verbose))
-		{
-			return 0;
-		}
-	}
+	const uint8_t* error = range_is_null_or_empty(error_file) ? NULL : error_file->start;
 
 	ptrdiff_t required_size = buffer_size(program);
 	required_size += range_size(base_dir);
@@ -857,12 +1623,13 @@ uint8_t exec(
 	if (spawn)
 	{
 		spawn = exec_posix_no_redirect(buffer_char_data(application, 0), cmd, env, work,
-									   pid_property, result_property, verbose);
+									   the_project, pid_property, verbose);
 	}
 	else
 	{
 		spawn = exec_posix_with_redirect(buffer_char_data(application, 0), cmd, env, work,
-										 file, application, time_out, result_property, verbose);
+										 the_project, append, file, output_property, error, error_property,
+										 application, time_out, result_property, verbose);
 	}
 
 	buffer_release(application);
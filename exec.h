@@ -20,12 +20,18 @@ uint8_t exec(
 	const struct range* base_dir,
 	const struct range* command_line,
 	const struct range* output_file,
-	void* pid_property,
-	void* result_property,
+	const struct range* output_property,
+	const struct range* error_file,
+	const struct range* error_property,
+	const struct range* pid_property,
+	const struct range* result_property,
 	const struct range* working_dir,
 	const struct range* environment_variables,
 	uint8_t spawn,
 	uint32_t time_out,
 	uint8_t verbose);
+uint8_t exec_wait(
+	const void* the_project, void* pids, uint32_t time_out,
+	const struct range* result_property, uint8_t verbose);
 
 #endif
@@ -5,6 +5,14 @@
  *
  */
 
+#if defined(__linux__)
+#define _GNU_SOURCE 1
+#endif
+
+#if !defined(_WIN32)
+#define _FILE_OFFSET_BITS 64
+#endif
+
 /*#if !defined(_WIN32)
 #if defined(__linux)
 #define _POSIX_SOURCE 1
@@ -21,6 +29,7 @@
 #include "common.h"
 #include "date_time.h"
 #include "environment.h"
+#include "hash.h"
 #include "interpreter.file_system.h"
 #include "path.h"
 #include "project.h"
@@ -28,18 +37,31 @@
 #include "range.h"
 #include "string_unit.h"
 #include "text_encoding.h"
+#include "thread.h"
 
 #include <stdio.h>
 #include <string.h>
 
 #if defined(_WIN32)
+#include <io.h>
 #include <windows.h>
 #else
 #include <utime.h>
 #include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#if defined(__linux__)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#endif
+#endif
+
+#if defined(__GLIBC__) && (2 < __GLIBC__ || (2 == __GLIBC__ && 27 <= __GLIBC_MINOR__))
+#define FILE_SYSTEM_COPY_FILE_RANGE 1
 #endif
 
 static const uint8_t zero = '\0';
@@ -47,6 +69,17 @@ static const uint8_t zero = '\0';
 static const wchar_t zeroW = L'\0';
 #endif
 
+static ptrdiff_t stat_cache_saved = 0;
+static ptrdiff_t stat_cache_performed = 0;
+#if !defined(_WIN32)
+static uint8_t stat_cache_entries_buffer[BUFFER_SIZE_OF];
+static uint8_t stat_cache_paths_buffer[BUFFER_SIZE_OF];
+static uint8_t stat_cache_mutex_buffer[BUFFER_SIZE_OF];
+static uint8_t is_stat_cache_init = 0;
+static ptrdiff_t stat_cache_count = 0;
+static uint32_t stat_cache_generation = 0;
+#endif
+
 #if defined(_WIN32)
 
 #define FIND_FILE_OBJECT_DATA(PATHW, DATA, RETURN, CLOSE_RESULT)\
@@ -439,7 +472,7 @@ uint8_t file_system_path_to_pathW(const uint8_t* path, void* pathW)
 	struct stat file_status;							\
 	file_status.st_size = 0;							\
 	\
-	if (stat((const char*)(PATH), &file_status) ||		\
+	if (!file_system_stat((PATH), &file_status) ||		\
 		!(S_IFDIR != (file_status.st_mode & S_IFDIR)))	\
 	{													\
 		return 0;										\
@@ -449,129 +482,1345 @@ uint8_t file_system_path_to_pathW(const uint8_t* path, void* pathW)
 	struct stat directory_status;							\
 	directory_status.st_size = 0;							\
 	\
-	if (stat((const char*)(PATH), &directory_status) ||		\
+	if (!file_system_stat((PATH), &directory_status) ||		\
 		S_IFDIR != (directory_status.st_mode & S_IFDIR))	\
 	{														\
 		return 0;											\
 	}
 
-uint8_t directory_delete_(const char* path)
+struct file_system_stat_entry
+{
+	struct stat status;
+	ptrdiff_t path;
+	ptrdiff_t path_length;
+	uint32_t hash;
+	uint8_t exists;
+	uint8_t is_actual;
+};
+
+struct file_system_stat_cache_nodes
+{
+	dev_t devices[2];
+	ino_t nodes[2];
+	uint8_t count;
+};
+
+uint8_t file_system_stat_cache_key(const uint8_t* path, void* output, struct range* key)
 {
-	return 0 == rmdir(path);
+	const uint8_t* start = path;
+	const uint8_t* finish = path + common_count_bytes_until(path, 0);
+	uint8_t is_normalized = !('.' == start[0] && path_posix_delimiter == start[1]);
+
+	for (const uint8_t* pos = start; is_normalized && pos < finish; ++pos)
+	{
+		if (path_posix_delimiter != *pos)
+		{
+			continue;
+		}
+
+		const uint8_t* next = pos + 1;
+
+		if (path_posix_delimiter == *next ||
+			('.' == *next && (finish == next + 1 || path_posix_delimiter == next[1])))
+		{
+			is_normalized = 0;
+		}
+	}
+
+	if (is_normalized)
+	{
+		key->start = start;
+		key->finish = finish;
+		return 1;
+	}
+
+	/*NOTE: only lexical form is normalized, '..' depends on symbolic links so kept as is,
+	  trailing delimiter also kept because it require the entry to be a directory.*/
+	const uint8_t is_directory = path_posix_delimiter == *(finish - 1) ||
+								 ('.' == *(finish - 1) && path_posix_delimiter == *(finish - 2));
+
+	if (!buffer_resize(output, 0) ||
+		(path_posix_delimiter == *start && !buffer_push_back(output, path_posix_delimiter)))
+	{
+		return 0;
+	}
+
+	while (start < finish)
+	{
+		const uint8_t* part_finish = start;
+
+		while (part_finish < finish && path_posix_delimiter != *part_finish)
+		{
+			++part_finish;
+		}
+
+		const ptrdiff_t length = part_finish - start;
+
+		if (0 < length &&
+			!(1 == length && '.' == *start))
+		{
+			const ptrdiff_t size = buffer_size(output);
+
+			if ((0 < size && path_posix_delimiter != *buffer_uint8_t_data(output, size - 1) &&
+				 !buffer_push_back(output, path_posix_delimiter)) ||
+				!buffer_append(output, start, length))
+			{
+				return 0;
+			}
+		}
+
+		start = part_finish < finish ? part_finish + 1 : finish;
+	}
+
+	const ptrdiff_t size = buffer_size(output);
+
+	if ((!size && !buffer_push_back(output, '.')) ||
+		(size && is_directory && path_posix_delimiter != *buffer_uint8_t_data(output, size - 1) &&
+		 !buffer_push_back(output, path_posix_delimiter)))
+	{
+		return 0;
+	}
+
+	key->start = buffer_uint8_t_data(output, 0);
+	key->finish = key->start + buffer_size(output);
+	return 1;
 }
 
-uint8_t directory_enumerate_file_system_entries_(
-	void* path,
-	const uint8_t* wild_card_start,
-	const uint8_t* wild_card_finish,
-	const uint8_t entry_type, const uint8_t recurse,
-	void* output, uint8_t fail_on_error)
+struct file_system_stat_entry* file_system_stat_cache_find(const struct range* key, uint32_t hash)
 {
-	if (NULL == path ||
-		range_in_parts_is_null_or_empty(wild_card_start, wild_card_finish) ||
-		file_system_get_id_of_all_entries() < entry_type ||
-		(0 != recurse && 1 != recurse) ||
-		NULL == output)
+	const void* entries = (const void*)stat_cache_entries_buffer;
+	const ptrdiff_t capacity = buffer_size(entries) / sizeof(struct file_system_stat_entry);
+
+	if (capacity < 1)
+	{
+		return NULL;
+	}
+
+	const uint8_t* paths = buffer_uint8_t_data((const void*)stat_cache_paths_buffer, 0);
+	const ptrdiff_t length = key->finish - key->start;
+	ptrdiff_t i = (ptrdiff_t)(hash & (uint32_t)(capacity - 1));
+
+	while (1)
+	{
+		struct file_system_stat_entry* entry =
+			(struct file_system_stat_entry*)buffer_data(entries, i * sizeof(struct file_system_stat_entry));
+
+		if (entry->path < 0 ||
+			(hash == entry->hash && length == entry->path_length &&
+			 0 == memcmp(paths + entry->path, key->start, length)))
+		{
+			return entry;
+		}
+
+		i = (i + 1) & (capacity - 1);
+	}
+}
+
+uint8_t file_system_stat_cache_grow()
+{
+	void* entries = (void*)stat_cache_entries_buffer;
+	const ptrdiff_t capacity = buffer_size(entries) / sizeof(struct file_system_stat_entry);
+
+	if (2 * (stat_cache_count + 1) <= capacity)
+	{
+		return 1;
+	}
+
+	uint8_t previous_buffer[BUFFER_SIZE_OF];
+	void* previous = (void*)previous_buffer;
+
+	if (!buffer_init(previous, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	if (!buffer_append_data_from_buffer(previous, entries) ||
+		!buffer_resize(entries, 0) ||
+		!buffer_append(entries, NULL, (capacity ? 2 * capacity : 256) * sizeof(struct file_system_stat_entry)))
+	{
+		buffer_release(previous);
+		return 0;
+	}
+
+	struct file_system_stat_entry* entry;
+	ptrdiff_t i = 0;
+
+	while (NULL != (entry = (struct file_system_stat_entry*)buffer_data(
+								entries, i++ * sizeof(struct file_system_stat_entry))))
+	{
+		entry->path = -1;
+	}
+
+	const uint8_t* paths = buffer_uint8_t_data((const void*)stat_cache_paths_buffer, 0);
+	i = 0;
+
+	while (NULL != (entry = (struct file_system_stat_entry*)buffer_data(
+								previous, i++ * sizeof(struct file_system_stat_entry))))
+	{
+		if (entry->path < 0)
+		{
+			continue;
+		}
+
+		struct range key;
+		key.start = paths + entry->path;
+		key.finish = key.start + entry->path_length;
+		/**/
+		*file_system_stat_cache_find(&key, entry->hash) = *entry;
+	}
+
+	buffer_release(previous);
+	return 1;
+}
+
+uint8_t file_system_stat(const uint8_t* path, struct stat* status)
+{
+	if (!is_stat_cache_init ||
+		zero == *path)
+	{
+		return 0 == stat((const char*)path, status);
+	}
+
+	uint8_t key_buffer[BUFFER_SIZE_OF];
+	void* key_in_a_buffer = (void*)key_buffer;
+
+	if (!buffer_init(key_in_a_buffer, BUFFER_SIZE_OF))
+	{
+		return 0 == stat((const char*)path, status);
+	}
+
+	struct range key;
+	uint32_t hash = 0;
+
+	if (!file_system_stat_cache_key(path, key_in_a_buffer, &key) ||
+		!hash_algorithm_XXH32(key.start, key.finish, 0, &hash))
+	{
+		buffer_release(key_in_a_buffer);
+		return 0 == stat((const char*)path, status);
+	}
+
+	void* mutex = (void*)stat_cache_mutex_buffer;
+	thread_mutex_lock(mutex);
+	struct file_system_stat_entry* entry = file_system_stat_cache_find(&key, hash);
+
+	if (NULL != entry &&
+		-1 < entry->path &&
+		entry->is_actual)
+	{
+		const uint8_t exists = entry->exists;
+		*status = entry->status;
+		++stat_cache_saved;
+		thread_mutex_unlock(mutex);
+		buffer_release(key_in_a_buffer);
+		return exists;
+	}
+
+	const uint32_t generation = stat_cache_generation;
+	thread_mutex_unlock(mutex);
+	/**/
+	const uint8_t exists = 0 == stat((const char*)path, status);
+	/**/
+	thread_mutex_lock(mutex);
+	++stat_cache_performed;
+
+	/*NOTE: result is not stored if something was changed while stat was called.*/
+	if (generation == stat_cache_generation &&
+		file_system_stat_cache_grow())
+	{
+		entry = file_system_stat_cache_find(&key, hash);
+
+		if (entry->path < 0)
+		{
+			void* paths = (void*)stat_cache_paths_buffer;
+			const ptrdiff_t size = buffer_size(paths);
+
+			if (buffer_append(paths, key.start, key.finish - key.start))
+			{
+				entry->path = size;
+				entry->path_length = key.finish - key.start;
+				entry->hash = hash;
+				++stat_cache_count;
+			}
+		}
+
+		if (-1 < entry->path)
+		{
+			entry->status = *status;
+			entry->exists = exists;
+			entry->is_actual = 1;
+		}
+	}
+
+	thread_mutex_unlock(mutex);
+	buffer_release(key_in_a_buffer);
+	return exists;
+}
+
+struct directory_filter
+{
+	const void* include;
+	const void* exclude;
+	ptrdiff_t root_size;
+	uint8_t entry_type;
+	uint8_t fail_on_error;
+};
+
+uint8_t directory_is_entry_a_directory(int directory, const struct dirent* entry)
+{
+	if (DT_UNKNOWN != entry->d_type)
+	{
+		return DT_DIR == entry->d_type;
+	}
+
+	/*NOTE: not every file system fill type of the entry, symbolic links are not followed as for DT_LNK.*/
+	struct stat entry_status;
+	return 0 == fstatat(directory, entry->d_name, &entry_status, AT_SYMLINK_NOFOLLOW) &&
+		   S_ISDIR(entry_status.st_mode);
+}
+
+uint8_t directory_is_entry_dot_or_dot_dot(const uint8_t* name, ptrdiff_t name_length)
+{
+	return '.' == name[0] && (1 == name_length || (2 == name_length && '.' == name[1]));
+}
+
+void directory_filter_entry(
+	const struct directory_filter* filter, const void* path, uint8_t is_directory,
+	uint8_t* is_match, uint8_t* descend)
+{
+	const uint8_t* relative_start = buffer_uint8_t_data(path, filter->root_size);
+	const uint8_t* relative_finish = relative_start + buffer_size(path) - filter->root_size;
+	/**/
+	*is_match = is_directory ?
+				file_system_get_id_of_file_entry() != filter->entry_type :
+				file_system_get_id_of_directory_entry() != filter->entry_type;
+	*is_match = *is_match &&
+				path_glob_compiled(filter->include, relative_start, relative_finish, path_glob_match) &&
+				(NULL == filter->exclude ||
+				 !path_glob_compiled(filter->exclude, relative_start, relative_finish, path_glob_match));
+	/*NOTE: sub directory is skipped when nothing in it can be included or everything in it is excluded.*/
+	*descend = is_directory &&
+			   path_glob_compiled(filter->include, relative_start, relative_finish, path_glob_may_match_under) &&
+			   (NULL == filter->exclude ||
+				!path_glob_compiled(filter->exclude, relative_start, relative_finish, path_glob_match_all_under));
+}
+
+uint8_t directory_enumerate_file_system_entries_at(
+	int parent, const char* name, void* path,
+	const struct directory_filter* filter, void* output)
+{
+	const int descriptor = openat(parent, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if (-1 == descriptor)
+	{
+		return filter->fail_on_error ? 0 : FAIL_WITH_OUT_ERROR;
+	}
+
+	DIR* directory = fdopendir(descriptor);
+
+	if (NULL == directory)
+	{
+		close(descriptor);
+		return filter->fail_on_error ? 0 : FAIL_WITH_OUT_ERROR;
+	}
+
+	const ptrdiff_t size = buffer_size(path);
+	struct dirent* entry = NULL;
+	uint8_t result = 1;
+
+	while (NULL != (entry = readdir(directory)))
+	{
+		const uint8_t* entry_name = (const uint8_t*)entry->d_name;
+		const ptrdiff_t name_length = common_count_bytes_until(entry_name, 0);
+
+		if (directory_is_entry_dot_or_dot_dot(entry_name, name_length))
+		{
+			continue;
+		}
+
+		if (!buffer_resize(path, size) ||
+			!buffer_append(path, entry_name, name_length))
+		{
+			closedir(directory);
+			return 0;
+		}
+
+		uint8_t is_match;
+		uint8_t descend;
+		directory_filter_entry(
+			filter, path, directory_is_entry_a_directory(dirfd(directory), entry), &is_match, &descend);
+
+		if (descend)
+		{
+			if (!buffer_push_back(path, PATH_DELIMITER))
+			{
+				closedir(directory);
+				return 0;
+			}
+
+			const uint8_t returned = directory_enumerate_file_system_entries_at(
+										 dirfd(directory), entry->d_name, path, filter, output);
+
+			if (!returned ||
+				!buffer_resize(path, size + name_length))
+			{
+				closedir(directory);
+				return 0;
+			}
+
+			result = FAIL_WITH_OUT_ERROR == returned ? returned : result;
+		}
+
+		if (is_match &&
+			(!buffer_append_data_from_buffer(output, path) ||
+			 !buffer_push_back(output, 0)))
+		{
+			closedir(directory);
+			return 0;
+		}
+	}
+
+	if (0 != closedir(directory) ||
+		!buffer_resize(path, size))
+	{
+		return 0;
+	}
+
+	return result;
+}
+
+struct directory_walk
+{
+	uint8_t mutex[BUFFER_SIZE_OF];
+	const struct directory_filter* filter;
+	const uint8_t* root;
+	const char** names;
+	void* outputs;
+	uint8_t* results;
+	ptrdiff_t count;
+	ptrdiff_t next;
+	int directory;
+};
+
+uint8_t directory_walk_worker(void* argument)
+{
+	struct directory_walk* walk = (struct directory_walk*)argument;
+	uint8_t path_buffer[BUFFER_SIZE_OF];
+	void* path = (void*)path_buffer;
+
+	if (!buffer_init(path, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	while (1)
+	{
+		thread_mutex_lock(walk->mutex);
+		const ptrdiff_t i = walk->next++;
+		thread_mutex_unlock(walk->mutex);
+
+		if (walk->count <= i)
+		{
+			break;
+		}
+
+		const uint8_t* name = (const uint8_t*)walk->names[i];
+
+		if (!buffer_resize(path, 0) ||
+			!buffer_append(path, walk->root, walk->filter->root_size) ||
+			!buffer_append(path, name, common_count_bytes_until(name, 0)) ||
+			!buffer_push_back(path, PATH_DELIMITER))
+		{
+			break;
+		}
+
+		walk->results[i] = directory_enumerate_file_system_entries_at(
+							   walk->directory, walk->names[i], path,
+							   walk->filter, buffer_buffer_data(walk->outputs, i));
+	}
+
+	buffer_release(path);
+	return 1;
+}
+
+ptrdiff_t directory_get_next_entry_record(const void* entries, ptrdiff_t position)
+{
+	return 3 + common_count_bytes_until(buffer_uint8_t_data(entries, position + 2), 0);
+}
+
+uint8_t directory_enumerate_file_system_entries_in_threads(
+	DIR* directory, void* path, const struct directory_filter* filter,
+	uint16_t threads, void* output, void* entries)
+{
+	struct dirent* entry = NULL;
+	ptrdiff_t count = 0;
+
+	while (NULL != (entry = readdir(directory)))
+	{
+		const uint8_t* entry_name = (const uint8_t*)entry->d_name;
+		const ptrdiff_t name_length = common_count_bytes_until(entry_name, 0);
+
+		if (directory_is_entry_dot_or_dot_dot(entry_name, name_length))
+		{
+			continue;
+		}
+
+		if (!buffer_resize(path, filter->root_size) ||
+			!buffer_append(path, entry_name, name_length))
+		{
+			return 0;
+		}
+
+		uint8_t is_match;
+		uint8_t descend;
+		directory_filter_entry(
+			filter, path, directory_is_entry_a_directory(dirfd(directory), entry), &is_match, &descend);
+
+		if (!buffer_push_back(entries, descend) ||
+			!buffer_push_back(entries, is_match) ||
+			!buffer_append(entries, entry_name, name_length + 1))
+		{
+			return 0;
+		}
+
+		count += descend;
+	}
+
+	const ptrdiff_t size = buffer_size(entries);
+	const ptrdiff_t aligned_size = sizeof(const char*) * ((size + sizeof(const char*) - 1) / sizeof(const char*));
+
+	if (!buffer_resize(path, filter->root_size) ||
+		!buffer_append(entries, NULL, aligned_size - size + count * (sizeof(const char*) + 1)))
 	{
 		return 0;
 	}
 
-	DIR* directory = opendir(buffer_char_data(path, 0));
+	struct directory_walk walk;
+	/**/
+	walk.filter = filter;
+	walk.root = buffer_uint8_t_data(path, 0);
+	walk.names = (const char**)buffer_data(entries, aligned_size);
+	walk.outputs = NULL;
+	walk.results = (uint8_t*)(walk.names + count);
+	walk.count = count;
+	walk.next = 0;
+	walk.directory = dirfd(directory);
+	/**/
+	ptrdiff_t i = 0;
+	ptrdiff_t position = 0;
+
+	while (position < size)
+	{
+		if (*buffer_uint8_t_data(entries, position))
+		{
+			walk.names[i] = buffer_char_data(entries, position + 2);
+			walk.results[i++] = 0;
+		}
+
+		position += directory_get_next_entry_record(entries, position);
+	}
+
+	uint8_t outputs_buffer[BUFFER_SIZE_OF];
+	walk.outputs = (void*)outputs_buffer;
+
+	if (!buffer_init(walk.outputs, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	for (i = 0; i < count; ++i)
+	{
+		uint8_t inner_buffer[BUFFER_SIZE_OF];
+
+		if (!buffer_init(inner_buffer, BUFFER_SIZE_OF) ||
+			!buffer_append_buffer(walk.outputs, inner_buffer, 1))
+		{
+			buffer_release_with_inner_buffers(walk.outputs);
+			return 0;
+		}
+	}
+
+	if (!buffer_init(walk.mutex, BUFFER_SIZE_OF) ||
+		!thread_mutex_init(walk.mutex))
+	{
+		thread_mutex_release(walk.mutex);
+		buffer_release_with_inner_buffers(walk.outputs);
+		return 0;
+	}
+
+	/*NOTE: walkers do not touch the project, so other targets can be interpreted meanwhile.*/
+	thread_leave_interpreter();
+	thread_run((uint16_t)MIN(threads, count), directory_walk_worker, &walk);
+	thread_enter_interpreter();
+	/**/
+	thread_mutex_release(walk.mutex);
+	/*NOTE: output is composed in the order of the entries, so it is the same as when walked by one thread.*/
+	uint8_t result = 1;
+	i = position = 0;
+
+	while (position < size)
+	{
+		const uint8_t* entry_name = buffer_uint8_t_data(entries, position + 2);
+		const ptrdiff_t name_length = common_count_bytes_until(entry_name, 0);
+
+		if (*buffer_uint8_t_data(entries, position))
+		{
+			if (!walk.results[i] ||
+				!buffer_append_data_from_buffer(output, buffer_buffer_data(walk.outputs, i)))
+			{
+				result = 0;
+				break;
+			}
+
+			result = FAIL_WITH_OUT_ERROR == walk.results[i++] ? FAIL_WITH_OUT_ERROR : result;
+		}
+
+		if (*buffer_uint8_t_data(entries, position + 1) &&
+			(!buffer_resize(path, filter->root_size) ||
+			 !buffer_append(path, entry_name, name_length) ||
+			 !buffer_append_data_from_buffer(output, path) ||
+			 !buffer_push_back(output, 0)))
+		{
+			result = 0;
+			break;
+		}
+
+		position += 3 + name_length;
+	}
+
+	buffer_release_with_inner_buffers(walk.outputs);
+	return result;
+}
+
+uint8_t directory_enumerate_file_system_entries_(
+	void* path, const void* include, const void* exclude,
+	const uint8_t entry_type, void* output, uint8_t fail_on_error, uint16_t threads)
+{
+	if (NULL == path ||
+		buffer_size(path) < 2 ||
+		NULL == include ||
+		file_system_get_id_of_all_entries() < entry_type ||
+		NULL == output)
+	{
+		return 0;
+	}
+
+	const int descriptor = open(buffer_char_data(path, 0), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if (-1 == descriptor)
+	{
+		return fail_on_error ? 0 : FAIL_WITH_OUT_ERROR;
+	}
+
+	uint8_t entries_buffer[BUFFER_SIZE_OF];
+	void* entries = (void*)entries_buffer;
+
+	if (!buffer_init(entries, BUFFER_SIZE_OF))
+	{
+		close(descriptor);
+		return 0;
+	}
+
+	/*NOTE: path only collect names for the output, entries are opened relatively to the descriptor of own directory.*/
+	const ptrdiff_t size = buffer_size(path);
+
+	if (!buffer_append(entries, buffer_data(path, 0), size - 1) ||
+		(PATH_DELIMITER != *buffer_uint8_t_data(entries, size - 2) &&
+		 !buffer_push_back(entries, PATH_DELIMITER)))
+	{
+		buffer_release(entries);
+		close(descriptor);
+		return 0;
+	}
+
+	struct directory_filter filter;
+	/**/
+	filter.include = include;
+	filter.exclude = exclude;
+	filter.root_size = buffer_size(entries);
+	filter.entry_type = entry_type;
+	filter.fail_on_error = fail_on_error;
+	/**/
+	uint8_t result = 0;
+
+	if (1 < threads)
+	{
+		DIR* directory = fdopendir(descriptor);
+
+		if (NULL == directory)
+		{
+			buffer_release(entries);
+			close(descriptor);
+			return fail_on_error ? 0 : FAIL_WITH_OUT_ERROR;
+		}
+
+		if (buffer_resize(path, 0) &&
+			buffer_append_data_from_buffer(path, entries) &&
+			buffer_resize(entries, 0))
+		{
+			result = directory_enumerate_file_system_entries_in_threads(
+						 directory, path, &filter, threads, output, entries);
+		}
+
+		result = 0 == closedir(directory) ? result : 0;
+
+		if (!buffer_resize(path, size - 1) ||
+			!buffer_push_back(path, 0))
+		{
+			result = 0;
+		}
+	}
+	else
+	{
+		result = directory_enumerate_file_system_entries_at(descriptor, ".", entries, &filter, output);
+		close(descriptor);
+	}
+
+	buffer_release(entries);
+	return result;
+}
+
+uint8_t directory_delete_add_failure(const void* path, ptrdiff_t length, void* failures)
+{
+	return buffer_append(failures, buffer_data(path, 0), length) &&
+		   buffer_push_back(failures, 0);
+}
+
+uint8_t directory_delete_at(int parent, const char* name, void* path, void* failures)
+{
+	/*NOTE: path end with delimiter, it only used to name the failures.*/
+	const ptrdiff_t size = buffer_size(path);
+	const ptrdiff_t failures_size = buffer_size(failures);
+	const int descriptor = openat(parent, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+	DIR* directory = -1 == descriptor ? NULL : fdopendir(descriptor);
+
+	if (NULL == directory)
+	{
+		if (-1 != descriptor)
+		{
+			close(descriptor);
+		}
+
+		return directory_delete_add_failure(path, size - 1, failures);
+	}
+
+	struct dirent* entry = NULL;
+
+	while (NULL != (entry = readdir(directory)))
+	{
+		const uint8_t* entry_name = (const uint8_t*)entry->d_name;
+		const ptrdiff_t name_length = common_count_bytes_until(entry_name, 0);
+
+		if (directory_is_entry_dot_or_dot_dot(entry_name, name_length))
+		{
+			continue;
+		}
+
+		if (!buffer_resize(path, size) ||
+			!buffer_append(path, entry_name, name_length))
+		{
+			closedir(directory);
+			return 0;
+		}
+
+		if (directory_is_entry_a_directory(dirfd(directory), entry))
+		{
+			if (!buffer_push_back(path, PATH_DELIMITER) ||
+				!directory_delete_at(dirfd(directory), entry->d_name, path, failures))
+			{
+				closedir(directory);
+				return 0;
+			}
+		}
+		else if (0 != unlinkat(dirfd(directory), entry->d_name, 0) &&
+				 ENOENT != errno &&
+				 !directory_delete_add_failure(path, buffer_size(path), failures))
+		{
+			closedir(directory);
+			return 0;
+		}
+	}
+
+	closedir(directory);
+
+	/*NOTE: directory with not deleted entry is kept silently, only the entry itself is the failure.*/
+	if (failures_size == buffer_size(failures) &&
+		0 != unlinkat(parent, name, AT_REMOVEDIR) &&
+		ENOENT != errno &&
+		!directory_delete_add_failure(path, size - 1, failures))
+	{
+		return 0;
+	}
+
+	return buffer_resize(path, size);
+}
+
+struct directory_delete_walk
+{
+	uint8_t mutex[BUFFER_SIZE_OF];
+	const uint8_t* root;
+	ptrdiff_t root_size;
+	const char** names;
+	void* failures;
+	uint8_t* results;
+	ptrdiff_t count;
+	ptrdiff_t next;
+	int directory;
+};
+
+uint8_t directory_delete_worker(void* argument)
+{
+	struct directory_delete_walk* walk = (struct directory_delete_walk*)argument;
+	uint8_t path_buffer[BUFFER_SIZE_OF];
+	void* path = (void*)path_buffer;
+
+	if (!buffer_init(path, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	while (1)
+	{
+		thread_mutex_lock(walk->mutex);
+		const ptrdiff_t i = walk->next++;
+		thread_mutex_unlock(walk->mutex);
+
+		if (walk->count <= i)
+		{
+			break;
+		}
+
+		const uint8_t* name = (const uint8_t*)walk->names[i];
+
+		if (!buffer_resize(path, 0) ||
+			!buffer_append(path, walk->root, walk->root_size) ||
+			!buffer_append(path, name, common_count_bytes_until(name, 0)) ||
+			!buffer_push_back(path, PATH_DELIMITER))
+		{
+			break;
+		}
+
+		walk->results[i] = directory_delete_at(
+							   walk->directory, walk->names[i], path,
+							   buffer_buffer_data(walk->failures, i));
+	}
+
+	buffer_release(path);
+	return 1;
+}
+
+uint8_t directory_delete_sub_directories_in_threads(
+	DIR* directory, const void* path, uint16_t threads, void* failures, void* entries)
+{
+	const ptrdiff_t start = buffer_size(entries);
+	struct dirent* entry = NULL;
+	ptrdiff_t count = 0;
+
+	/*NOTE: files of the root are removed at once, sub directories are the jobs for the workers.*/
+	while (NULL != (entry = readdir(directory)))
+	{
+		const uint8_t* entry_name = (const uint8_t*)entry->d_name;
+		const ptrdiff_t name_length = common_count_bytes_until(entry_name, 0);
+
+		if (directory_is_entry_dot_or_dot_dot(entry_name, name_length))
+		{
+			continue;
+		}
+
+		if (directory_is_entry_a_directory(dirfd(directory), entry))
+		{
+			if (!buffer_append(entries, entry_name, name_length + 1))
+			{
+				return 0;
+			}
+
+			++count;
+		}
+		else if (0 != unlinkat(dirfd(directory), entry->d_name, 0) &&
+				 ENOENT != errno &&
+				 (!buffer_append_data_from_buffer(failures, path) ||
+				  !buffer_append(failures, entry_name, name_length + 1)))
+		{
+			return 0;
+		}
+	}
+
+	if (!count)
+	{
+		return 1;
+	}
+
+	const ptrdiff_t size = buffer_size(entries);
+	const ptrdiff_t aligned_size = sizeof(const char*) * ((size + sizeof(const char*) - 1) / sizeof(const char*));
+
+	if (!buffer_append(entries, NULL, aligned_size - size + count * (sizeof(const char*) + 1)))
+	{
+		return 0;
+	}
+
+	struct directory_delete_walk walk;
+	/**/
+	walk.root = buffer_uint8_t_data(path, 0);
+	walk.root_size = buffer_size(path);
+	walk.names = (const char**)buffer_data(entries, aligned_size);
+	walk.failures = NULL;
+	walk.results = (uint8_t*)(walk.names + count);
+	walk.count = count;
+	walk.next = 0;
+	walk.directory = dirfd(directory);
+	/**/
+	ptrdiff_t i = 0;
+	ptrdiff_t position = start;
+
+	while (position < size)
+	{
+		walk.names[i] = buffer_char_data(entries, position);
+		walk.results[i++] = 0;
+		position += 1 + common_count_bytes_until(buffer_uint8_t_data(entries, position), 0);
+	}
+
+	uint8_t failures_buffer[BUFFER_SIZE_OF];
+	walk.failures = (void*)failures_buffer;
+
+	if (!buffer_init(walk.failures, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	for (i = 0; i < count; ++i)
+	{
+		uint8_t inner_buffer[BUFFER_SIZE_OF];
+
+		if (!buffer_init(inner_buffer, BUFFER_SIZE_OF) ||
+			!buffer_append_buffer(walk.failures, inner_buffer, 1))
+		{
+			buffer_release_with_inner_buffers(walk.failures);
+			return 0;
+		}
+	}
+
+	if (!buffer_init(walk.mutex, BUFFER_SIZE_OF) ||
+		!thread_mutex_init(walk.mutex))
+	{
+		thread_mutex_release(walk.mutex);
+		buffer_release_with_inner_buffers(walk.failures);
+		return 0;
+	}
+
+	threads = (uint16_t)MIN(threads, count);
+
+	if (1 < threads)
+	{
+		thread_leave_interpreter();
+		thread_run(threads, directory_delete_worker, &walk);
+		thread_enter_interpreter();
+	}
+	else
+	{
+		directory_delete_worker(&walk);
+	}
+
+	thread_mutex_release(walk.mutex);
+	/*NOTE: failures are listed in the order of the entries, not in the order of the workers.*/
+	uint8_t result = 1;
+
+	for (i = 0; i < count; ++i)
+	{
+		if (!walk.results[i] ||
+			!buffer_append_data_from_buffer(failures, buffer_buffer_data(walk.failures, i)))
+		{
+			result = 0;
+			break;
+		}
+	}
+
+	buffer_release_with_inner_buffers(walk.failures);
+	return result;
+}
+
+uint8_t directory_delete_with_descriptors(const uint8_t* path, uint16_t threads, void* failures)
+{
+	uint8_t entries_buffer[BUFFER_SIZE_OF];
+	void* entries = (void*)entries_buffer;
+
+	if (!buffer_init(entries, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	const uint8_t* finish = path + common_count_bytes_until(path, 0);
+
+	while (path + 1 < finish && PATH_DELIMITER == *(finish - 1))
+	{
+		--finish;
+	}
+
+	/*NOTE: entries start with the zero ended path, names of the sub directories are placed after it.*/
+	const ptrdiff_t path_length = finish - path;
+
+	if (!buffer_append(entries, path, path_length) ||
+		!buffer_push_back(entries, 0) ||
+		!buffer_append(entries, path, path_length) ||
+		(PATH_DELIMITER != *(finish - 1) && !buffer_push_back(entries, PATH_DELIMITER)))
+	{
+		buffer_release(entries);
+		return 0;
+	}
+
+	const ptrdiff_t size = buffer_size(entries);
+	const int descriptor = open(buffer_char_data(entries, 0), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+	DIR* directory = -1 == descriptor ? NULL : fdopendir(descriptor);
+
+	if (NULL == directory)
+	{
+		if (-1 != descriptor)
+		{
+			close(descriptor);
+		}
+
+		struct stat status;
+
+		/*NOTE: symbolic link to the directory is deleted itself, not the entries it point to.*/
+		if (-1 == descriptor &&
+			(ELOOP == errno || ENOTDIR == errno) &&
+			0 == lstat(buffer_char_data(entries, 0), &status) &&
+			S_ISLNK(status.st_mode) &&
+			0 == unlink(buffer_char_data(entries, 0)))
+		{
+			buffer_release(entries);
+			return 1;
+		}
+
+		const uint8_t result = buffer_append(failures, path, path_length) && buffer_push_back(failures, 0);
+		buffer_release(entries);
+		return result;
+	}
+
+	uint8_t root_buffer[BUFFER_SIZE_OF];
+	void* root = (void*)root_buffer;
+
+	if (!buffer_init(root, BUFFER_SIZE_OF) ||
+		!buffer_append(root, buffer_data(entries, path_length + 1), size - path_length - 1) ||
+		!buffer_resize(entries, path_length + 1))
+	{
+		buffer_release(root);
+		buffer_release(entries);
+		closedir(directory);
+		return 0;
+	}
+
+	const ptrdiff_t failures_size = buffer_size(failures);
+	uint8_t result = directory_delete_sub_directories_in_threads(directory, root, threads, failures, entries);
+	buffer_release(root);
+	closedir(directory);
+
+	if (result &&
+		failures_size == buffer_size(failures) &&
+		0 != rmdir(buffer_char_data(entries, 0)) &&
+		ENOENT != errno)
+	{
+		result = buffer_append(failures, path, path_length) && buffer_push_back(failures, 0);
+	}
+
+	buffer_release(entries);
+	return result;
+}
+
+void file_system_stat_cache_mark(const uint8_t* start, const uint8_t* finish, void* tmp)
+{
+	if (!buffer_resize(tmp, 0) ||
+		!buffer_append(tmp, start, finish - start) ||
+		!buffer_push_back(tmp, path_posix_delimiter))
+	{
+		return;
+	}
+
+	struct range key;
+	key.start = buffer_uint8_t_data(tmp, 0);
+	key.finish = key.start + buffer_size(tmp);
+
+	for (uint8_t i = 0; i < 2; ++i, --key.finish)
+	{
+		uint32_t hash = 0;
+
+		if (key.start == key.finish ||
+			!hash_algorithm_XXH32(key.start, key.finish, 0, &hash))
+		{
+			continue;
+		}
+
+		struct file_system_stat_entry* entry = file_system_stat_cache_find(&key, hash);
+
+		if (NULL != entry)
+		{
+			entry->is_actual = 0;
+		}
+	}
+}
+
+void file_system_stat_cache_mark_all(uint8_t only_not_exists)
+{
+	const void* entries = (const void*)stat_cache_entries_buffer;
+	/**/
+	struct file_system_stat_entry* entry;
+	ptrdiff_t i = 0;
+
+	while (NULL != (entry = (struct file_system_stat_entry*)buffer_data(
+								entries, i++ * sizeof(struct file_system_stat_entry))))
+	{
+		if (!only_not_exists || !entry->exists)
+		{
+			entry->is_actual = 0;
+		}
+	}
+}
+
+void file_system_stat_cache_mark_node(dev_t device, ino_t node)
+{
+	const void* entries = (const void*)stat_cache_entries_buffer;
+	/**/
+	struct file_system_stat_entry* entry;
+	ptrdiff_t i = 0;
+
+	while (NULL != (entry = (struct file_system_stat_entry*)buffer_data(
+								entries, i++ * sizeof(struct file_system_stat_entry))))
+	{
+		if (-1 < entry->path &&
+			entry->exists &&
+			device == entry->status.st_dev &&
+			node == entry->status.st_ino)
+		{
+			entry->is_actual = 0;
+		}
+	}
+}
+
+void file_system_stat_cache_invalidate_entry(dev_t device, ino_t node)
+{
+	void* mutex = (void*)stat_cache_mutex_buffer;
+	/**/
+	thread_mutex_lock(mutex);
+	++stat_cache_generation;
+	file_system_stat_cache_mark_node(device, node);
+	thread_mutex_unlock(mutex);
+}
+
+void file_system_stat_cache_get_nodes(const uint8_t* path, struct file_system_stat_cache_nodes* nodes)
+{
+	nodes->count = 0;
+
+	if (!is_stat_cache_init ||
+		NULL == path ||
+		zero == *path)
+	{
+		return;
+	}
+
+	/*NOTE: entry itself and, for symbolic link, the target of it, because cache keep status of the target.*/
+	struct stat status;
+
+	if (0 == lstat((const char*)path, &status))
+	{
+		nodes->devices[nodes->count] = status.st_dev;
+		nodes->nodes[nodes->count] = status.st_ino;
+		++nodes->count;
+
+		if (S_ISLNK(status.st_mode) &&
+			0 == stat((const char*)path, &status))
+		{
+			nodes->devices[nodes->count] = status.st_dev;
+			nodes->nodes[nodes->count] = status.st_ino;
+			++nodes->count;
+		}
+	}
+}
+
+void file_system_stat_cache_invalidate_nodes(const struct file_system_stat_cache_nodes* nodes)
+{
+	if (!is_stat_cache_init ||
+		!nodes->count)
+	{
+		return;
+	}
+
+	void* mutex = (void*)stat_cache_mutex_buffer;
+	thread_mutex_lock(mutex);
+	++stat_cache_generation;
+
+	for (uint8_t i = 0; i < nodes->count; ++i)
+	{
+		file_system_stat_cache_mark_node(nodes->devices[i], nodes->nodes[i]);
+	}
+
+	thread_mutex_unlock(mutex);
+}
+#endif
+uint8_t file_system_set_stat_cache(uint8_t enable)
+{
+#if defined(_WIN32)
+	/*TODO: stat cache not yet implemented at Windows.*/
+	(void)enable;
+	return 1;
+#else
+
+	if (!enable ||
+		is_stat_cache_init)
+	{
+		return 1;
+	}
+
+	if (!buffer_init((void*)stat_cache_entries_buffer, BUFFER_SIZE_OF) ||
+		!buffer_init((void*)stat_cache_paths_buffer, BUFFER_SIZE_OF) ||
+		!buffer_init((void*)stat_cache_mutex_buffer, BUFFER_SIZE_OF) ||
+		!thread_mutex_init((void*)stat_cache_mutex_buffer))
+	{
+		buffer_release((void*)stat_cache_entries_buffer);
+		buffer_release((void*)stat_cache_paths_buffer);
+		buffer_release((void*)stat_cache_mutex_buffer);
+		return 0;
+	}
+
+	stat_cache_count = stat_cache_saved = stat_cache_performed = 0;
+	is_stat_cache_init = 1;
+	return 1;
+#endif
+}
+
+void file_system_stat_cache_invalidate(const uint8_t* path, uint8_t with_content)
+{
+#if defined(_WIN32)
+	(void)path;
+	(void)with_content;
+#else
+
+	if (!is_stat_cache_init)
+	{
+		return;
+	}
+
+	uint8_t key_buffer[BUFFER_SIZE_OF];
+	void* key_in_a_buffer = (void*)key_buffer;
+	uint8_t tmp_buffer[BUFFER_SIZE_OF];
+	void* tmp = (void*)tmp_buffer;
+	struct range key;
+	key.start = key.finish = NULL;
 
-	if (NULL == directory)
+	if (!buffer_init(key_in_a_buffer, BUFFER_SIZE_OF) ||
+		!buffer_init(tmp, BUFFER_SIZE_OF))
 	{
-		return fail_on_error ? 0 : FAIL_WITH_OUT_ERROR;
+		path = NULL;
 	}
 
-	const ptrdiff_t size = buffer_size(path);
-	struct dirent* entry = NULL;
-	uint8_t result = 1;
+	if (NULL != path &&
+		(with_content || zero == *path || !file_system_stat_cache_key(path, key_in_a_buffer, &key)))
+	{
+		path = NULL;
+	}
 
-	while (NULL != (entry = readdir(directory)))
+	/*NOTE: same entry can be cached with other spelling of the path, such one is found by the node
+	  of the entry and of the parent directory, that are taken after the change.*/
+	struct file_system_stat_cache_nodes nodes[2];
+	nodes[0].count = nodes[1].count = 0;
+	const uint8_t* pos = key.finish;
+
+	if (NULL != path)
 	{
-		const size_t name_length = common_count_bytes_until((const uint8_t*)entry->d_name, 0);
+		file_system_stat_cache_get_nodes(path, &nodes[0]);
 
-		if (DT_DIR == entry->d_type)
+		if (key.start + 1 < key.finish &&
+			path_posix_delimiter == *(key.finish - 1))
 		{
-			if ((1 == name_length && 0 == memcmp(".", entry->d_name, name_length)) ||
-				(2 == name_length && 0 == memcmp("..", entry->d_name, name_length)))
-			{
-				continue;
-			}
+			--key.finish;
 		}
 
-		if (!buffer_resize(path, size - 1) ||
-			!path_combine_in_place(path, size - 2, (const uint8_t*)entry->d_name,
-								   (const uint8_t*)(entry->d_name + name_length)) ||
-			!buffer_push_back(path, 0))
+		pos = key.finish;
+
+		while (key.start < pos &&
+			   path_posix_delimiter != *(pos - 1))
 		{
-			closedir(directory);
-			return 0;
+			--pos;
 		}
 
-		if (DT_DIR == entry->d_type)
+		if (key.start == pos)
 		{
-			if (recurse)
-			{
-				if (!(result = directory_enumerate_file_system_entries_(
-								   path, wild_card_start, wild_card_finish,
-								   entry_type, recurse, output, fail_on_error)))
-				{
-					closedir(directory);
-					return 0;
-				}
-			}
+			file_system_stat_cache_get_nodes((const uint8_t*)".", &nodes[1]);
+		}
+		else if (buffer_resize(tmp, 0) &&
+				 buffer_append(tmp, key.start, key.start + 1 < pos ? pos - 1 - key.start : pos - key.start) &&
+				 buffer_push_back(tmp, 0))
+		{
+			file_system_stat_cache_get_nodes(buffer_uint8_t_data(tmp, 0), &nodes[1]);
+		}
+	}
 
-			if (file_system_get_id_of_file_entry() == entry_type)
-			{
-				if (!buffer_resize(path, size - 1) ||
-					!buffer_push_back(path, 0))
-				{
-					closedir(directory);
-					return 0;
-				}
+	void* mutex = (void*)stat_cache_mutex_buffer;
+	thread_mutex_lock(mutex);
+	++stat_cache_generation;
 
-				continue;
-			}
-		}
-		else if (file_system_get_id_of_directory_entry() == entry_type)
+	/*NOTE: content of the directory can be cached with any spelling of the path, so everything is refreshed.*/
+	if (NULL == path)
+	{
+		file_system_stat_cache_mark_all(0);
+	}
+	else
+	{
+		/*NOTE: any path that was not exist can be an alias of the created entry.*/
+		file_system_stat_cache_mark_all(1);
+		file_system_stat_cache_mark(key.start, key.finish, tmp);
+
+		for (uint8_t i = 0; i < COUNT_OF(nodes); ++i)
 		{
-			if (!buffer_resize(path, size - 1) ||
-				!buffer_push_back(path, 0))
+			for (uint8_t j = 0; j < nodes[i].count; ++j)
 			{
-				closedir(directory);
-				return 0;
+				file_system_stat_cache_mark_node(nodes[i].devices[j], nodes[i].nodes[j]);
 			}
-
-			continue;
 		}
 
-		const uint8_t* path_start = buffer_uint8_t_data(path, 0);
-		const uint8_t* path_finish = path_start + buffer_size(path);
-
-		if (!path_glob(path_start, path_finish,
-					   wild_card_start, wild_card_finish))
+		/*NOTE: creation or removal of the entry also change the parent directory.*/
+		if (key.start == pos)
 		{
-			continue;
+			file_system_stat_cache_mark((const uint8_t*)".", (const uint8_t*)"." + 1, tmp);
 		}
-
-		if (!buffer_append_data_from_buffer(output, path) ||
-			!buffer_resize(path, size - 1) ||
-			!buffer_push_back(path, 0))
+		else
 		{
-			closedir(directory);
-			return 0;
+			file_system_stat_cache_mark(key.start, key.start + 1 < pos ? pos - 1 : pos, tmp);
 		}
 	}
 
-	if (0 != closedir(directory))
+	thread_mutex_unlock(mutex);
+	buffer_release(tmp);
+	buffer_release(key_in_a_buffer);
+#endif
+}
+
+void file_system_get_stat_cache_statistics(ptrdiff_t* saved, ptrdiff_t* performed)
+{
+	if (NULL != saved)
 	{
-		return 0;
+		*saved = stat_cache_saved;
 	}
 
-	return result;
+	if (NULL != performed)
+	{
+		*performed = stat_cache_performed;
+	}
 }
+
+void file_system_release_stat_cache()
+{
+#if !defined(_WIN32)
+
+	if (is_stat_cache_init)
+	{
+		thread_mutex_release((void*)stat_cache_mutex_buffer);
+		buffer_release((void*)stat_cache_mutex_buffer);
+		buffer_release((void*)stat_cache_paths_buffer);
+		buffer_release((void*)stat_cache_entries_buffer);
+		is_stat_cache_init = 0;
+	}
+
 #endif
+}
+
 uint8_t directory_create(const uint8_t* path)
 {
 	if (NULL == path)
@@ -679,21 +1928,21 @@ uint8_t directory_create(const uint8_t* path)
 				buffer_release(current_directory);
 				return 0;
 			}
+
+			file_system_stat_cache_invalidate(path_, 0);
 		}
 	}
 
 	buffer_release(current_directory);
-	return 0 == mkdir((const char*)path, mode);
+	const uint8_t returned = 0 == mkdir((const char*)path, mode);
+	file_system_stat_cache_invalidate(path, 0);
+	return returned;
 #endif
 }
 
-uint8_t directory_delete(const uint8_t* path)
+#if defined(_WIN32)
+uint8_t directory_delete_tree(const uint8_t* path)
 {
-	if (NULL == path)
-	{
-		return 0;
-	}
-
 	uint8_t pathW_buffer[BUFFER_SIZE_OF];
 	void* pathW = (void*)pathW_buffer;
 
@@ -702,8 +1951,6 @@ uint8_t directory_delete(const uint8_t* path)
 		return 0;
 	}
 
-#if defined(_WIN32)
-
 	if (!file_system_path_to_pathW(path, pathW))
 	{
 		buffer_release(pathW);
@@ -719,16 +1966,6 @@ uint8_t directory_delete(const uint8_t* path)
 		return 0;
 	}
 
-#else
-
-	if (!buffer_append(pathW, path, common_count_bytes_until(path, 0)) ||
-		!buffer_push_back(pathW, 0))
-	{
-		buffer_release(pathW);
-		return 0;
-	}
-
-#endif
 	uint8_t entries_buffer[BUFFER_SIZE_OF];
 	void* entries = (void*)entries_buffer;
 
@@ -747,82 +1984,44 @@ uint8_t directory_delete(const uint8_t* path)
 			return 0;
 		}
 
-#if defined(_WIN32)
-
 		if (!directory_enumerate_file_system_entries_wchar_t(pathW, entry, 1, UTF16LE, entries, 1))
-#else
-		if (!directory_enumerate_file_system_entries(pathW, entry, 1, entries, 1))
-#endif
 		{
 			buffer_release(entries);
 			buffer_release(pathW);
 			return 0;
 		}
 
-#if defined(_WIN32)
 		const wchar_t* start = buffer_wchar_t_data(entries, 0);
 		const wchar_t* finish = (const wchar_t*)(buffer_uint8_t_data(entries, 0) + buffer_size(entries));
-#else
-		const uint8_t* start = buffer_uint8_t_data(entries, 0);
-		const uint8_t* finish = start + buffer_size(entries);
-#endif
 
 		if (file_system_get_id_of_file_entry() == entry)
 		{
 			while (start != finish)
 			{
-#if defined(_WIN32)
-
 				if (0 == DeleteFileW(start))
-#else
-				if (0 != remove((const char*)start))
-#endif
 				{
 					buffer_release(entries);
 					buffer_release(pathW);
 					return 0;
 				}
 
-#if defined(_WIN32)
 				start = find_any_symbol_like_or_not_like_that_wchar_t(start, finish, &zeroW, 1, 1, 1);
 				start = find_any_symbol_like_or_not_like_that_wchar_t(start, finish, &zeroW, 1, 0, 1);
-#else
-				start =
-					string_find_any_symbol_like_or_not_like_that(
-						start, finish, &zero, &zero + 1, 1, 1);
-				start =
-					string_find_any_symbol_like_or_not_like_that(
-						start, finish, &zero, &zero + 1, 0, 1);
-#endif
 			}
 		}
 		else
 		{
 			while (start != finish)
 			{
-#if defined(_WIN32)
-
 				if (!directory_delete_wchar_t(start))
-#else
-				if (!directory_delete_((const char*)start))
-#endif
 				{
 					buffer_release(entries);
 					buffer_release(pathW);
 					return 0;
 				}
 
-#if defined(_WIN32)
 				start = find_any_symbol_like_or_not_like_that_wchar_t(start, finish, &zeroW, 1, 1, 1);
 				start = find_any_symbol_like_or_not_like_that_wchar_t(start, finish, &zeroW, 1, 0, 1);
-#else
-				start =
-					string_find_any_symbol_like_or_not_like_that(
-						start, finish, &zero, &zero + 1, 1, 1);
-				start =
-					string_find_any_symbol_like_or_not_like_that(
-						start, finish, &zero, &zero + 1, 0, 1);
-#endif
 			}
 
 			break;
@@ -830,7 +2029,6 @@ uint8_t directory_delete(const uint8_t* path)
 	}
 
 	buffer_release(entries);
-#if defined(_WIN32)
 
 	if (!buffer_resize(pathW, size - sizeof(wchar_t)) ||
 		!buffer_push_back_uint16_t(pathW, 0))
@@ -840,9 +2038,6 @@ uint8_t directory_delete(const uint8_t* path)
 	}
 
 	if (!directory_delete_wchar_t(buffer_wchar_t_data(pathW, 0)))
-#else
-	if (!directory_delete_(buffer_char_data(pathW, 0)))
-#endif
 	{
 		buffer_release(pathW);
 		return 0;
@@ -851,10 +2046,63 @@ uint8_t directory_delete(const uint8_t* path)
 	buffer_release(pathW);
 	return 1;
 }
+#endif
+
+uint8_t directory_delete(const uint8_t* path)
+{
+	if (NULL == path)
+	{
+		return 0;
+	}
+
+#if defined(_WIN32)
+	const uint8_t returned = directory_delete_tree(path);
+#else
+	uint8_t failures_buffer[BUFFER_SIZE_OF];
+	void* failures = (void*)failures_buffer;
+
+	if (!buffer_init(failures, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	const uint8_t returned = directory_delete_with_descriptors(path, 1, failures) && !buffer_size(failures);
+	buffer_release(failures);
+#endif
+	file_system_stat_cache_invalidate(path, 1);
+	return returned;
+}
+
+uint8_t directory_delete_with_threads(const uint8_t* path, uint16_t threads, void* failures)
+{
+	if (NULL == path ||
+		NULL == failures)
+	{
+		return 0;
+	}
+
+	const ptrdiff_t size = buffer_size(failures);
+#if defined(_WIN32)
+	/*TODO: walk with handles of the directories and delete sub directories in threads.*/
+	(void)threads;
+	uint8_t returned = directory_delete_tree(path);
+
+	if (!returned)
+	{
+		returned = buffer_append(failures, path, common_count_bytes_until(path, 0)) &&
+				   buffer_push_back(failures, 0);
+	}
+
+#else
+	const uint8_t returned = directory_delete_with_descriptors(path, threads, failures);
+#endif
+	file_system_stat_cache_invalidate(path, 1);
+	return returned && size == buffer_size(failures);
+}
 
 uint8_t directory_enumerate_file_system_entries(
-	void* path, const uint8_t entry_type, const uint8_t recurse,
-	void* output, uint8_t fail_on_error)
+	void* path, const uint8_t entry_type, const uint8_t recurse, const void* exclude,
+	void* output, uint8_t fail_on_error, uint16_t threads)
 {
 	if (NULL == path ||
 		file_system_get_id_of_all_entries() < entry_type ||
@@ -867,18 +2115,18 @@ uint8_t directory_enumerate_file_system_entries(
 	struct range file_name;
 
 	BUFFER_TO_RANGE(file_name, path);
-
-	if (!path_get_file_name(&file_name.start, file_name.finish))
-	{
-		return 0;
-	}
-
 	static const uint8_t* question_mark_and_asterisk = (const uint8_t*)"?*";
+	const uint8_t* wild_card_start = string_find_any_symbol_like_or_not_like_that(
+										 file_name.start, file_name.finish,
+										 question_mark_and_asterisk, question_mark_and_asterisk + 2, 1, 1);
 
-	if (file_name.finish == string_find_any_symbol_like_or_not_like_that(
-			file_name.start, file_name.finish,
-			question_mark_and_asterisk, question_mark_and_asterisk + 2, 1, 1))
+	if (file_name.finish == wild_card_start)
 	{
+		if (!path_get_file_name(&file_name.start, file_name.finish))
+		{
+			return 0;
+		}
+
 		const ptrdiff_t index = file_name.start - buffer_uint8_t_data(path, 0);
 
 		if (!buffer_resize(path, buffer_size(path) - 1) ||
@@ -908,15 +2156,28 @@ uint8_t directory_enumerate_file_system_entries(
 		return 0;
 	}
 
+	/*TODO: wild card at the directory part of the path, '**' and excluding are not supported at this platform.*/
 	const uint8_t returned = directory_enumerate_file_system_entries_wchar_t(
 								 patternW, entry_type, recurse, UTF8, output, fail_on_error);
 	/**/
 	buffer_release(patternW);
+	(void)exclude;
+	(void)threads;
 	return returned;
 #else
+	/*NOTE: directories up to the first part with wild card are opened directly, the rest is compiled into glob.*/
 	BUFFER_TO_RANGE(file_name, path);
+	wild_card_start = string_find_any_symbol_like_or_not_like_that(
+						  file_name.start, file_name.finish,
+						  question_mark_and_asterisk, question_mark_and_asterisk + 2, 1, 1);
+
+	while (file_name.start < wild_card_start &&
+		   PATH_DELIMITER != *(wild_card_start - 1))
+	{
+		--wild_card_start;
+	}
 
-	if (!path_get_file_name(&file_name.start, file_name.finish))
+	if (file_name.start == wild_card_start)
 	{
 		return 0;
 	}
@@ -929,29 +2190,40 @@ uint8_t directory_enumerate_file_system_entries(
 		return 0;
 	}
 
-	if (!buffer_append_data_from_range(wild_card, &file_name))
+	static const uint8_t* any_directories = (const uint8_t*)"**/";
+
+	if ((recurse && !buffer_append(wild_card, any_directories, 3)) ||
+		!buffer_append(wild_card, wild_card_start, file_name.finish - 1 - wild_card_start))
 	{
 		buffer_release(wild_card);
 		return 0;
 	}
 
-	BUFFER_TO_RANGE(file_name, path);
+	uint8_t include_buffer[BUFFER_SIZE_OF];
+	void* include = (void*)include_buffer;
+
+	if (!buffer_init(include, BUFFER_SIZE_OF))
+	{
+		buffer_release(wild_card);
+		return 0;
+	}
+
+	BUFFER_TO_RANGE(file_name, wild_card);
 
-	if (!path_get_directory_name(file_name.start, &file_name.finish) ||
-		!buffer_resize(path, range_size(&file_name)) ||
+	if (!path_glob_compile(file_name.start, file_name.finish, include) ||
+		!buffer_resize(path, MAX(1, wild_card_start - 1 - buffer_uint8_t_data(path, 0))) ||
 		!buffer_push_back(path, 0))
 	{
+		buffer_release(include);
 		buffer_release(wild_card);
 		return 0;
 	}
 
-	const uint8_t* wild_card_start = buffer_uint8_t_data(wild_card, 0);
-	const uint8_t* wild_card_finish = wild_card_start + buffer_size(wild_card);
+	buffer_release(wild_card);
 	/**/
 	const uint8_t returned = directory_enumerate_file_system_entries_(
-								 path, wild_card_start, wild_card_finish,
-								 entry_type, recurse, output, fail_on_error);
-	buffer_release(wild_card);
+								 path, include, exclude, entry_type, output, fail_on_error, threads);
+	buffer_release(include);
 	return returned;
 #endif
 }
@@ -982,15 +2254,9 @@ uint8_t directory_exists(const uint8_t* path)
 	buffer_release(pathW);
 	return returned;
 #else
-	DIR* dir = opendir((const char*)path);
-
-	if (NULL == dir)
-	{
-		return 0;
-	}
-
-	closedir(dir);
-	return 1;
+	struct stat directory_status;
+	directory_status.st_mode = 0;
+	return file_system_stat(path, &directory_status) && S_IFDIR == (directory_status.st_mode & S_IFDIR);
 #endif
 }
 
@@ -1266,7 +2532,10 @@ uint8_t directory_move(const uint8_t* current_path, const uint8_t* new_path)
 		return 0;
 	}
 
-	return file_system_move_entry(current_path, new_path);
+	const uint8_t returned = file_system_move_entry(current_path, new_path);
+	file_system_stat_cache_invalidate(current_path, 1);
+	file_system_stat_cache_invalidate(new_path, 1);
+	return returned;
 #endif
 }
 
@@ -1392,7 +2661,10 @@ uint8_t directory_set_current_directory(const uint8_t* path)
 	buffer_release(pathW);
 	return returned;
 #else
-	return -1 != chdir((const char*)path);
+	const uint8_t returned = -1 != chdir((const char*)path);
+	/*NOTE: relative paths at the cache point to the other entries now.*/
+	file_system_stat_cache_invalidate(NULL, 0);
+	return returned;
 #endif
 }
 #if defined(_WIN32)
@@ -1417,31 +2689,159 @@ uint8_t file_append(const uint8_t* path, const struct range* data, uint16_t enco
 		return 0;
 	}
 
-	if (!file_write_with_encoding(data, encoding, file))
+	if (!file_write_with_encoding(data, encoding, file))
+	{
+		file_close(file);
+		return 0;
+	}
+
+	return file_close(file);
+}
+
+uint8_t file_close(void* stream)
+{
+#if !defined(_WIN32)
+	struct stat status;
+
+	/*NOTE: size and time of the entry written by the stream known only after it closed.*/
+	if (is_stat_cache_init &&
+		NULL != stream &&
+		O_RDONLY != (fcntl(fileno((FILE*)stream), F_GETFL) & O_ACCMODE) &&
+		0 == fstat(fileno((FILE*)stream), &status))
+	{
+		const uint8_t returned = 0 == fclose((FILE*)stream);
+		file_system_stat_cache_invalidate_entry(status.st_dev, status.st_ino);
+		return returned;
+	}
+
+#endif
+	return NULL != stream &&
+		   0 == fclose((FILE*)stream);
+}
+#if defined(_WIN32)
+uint8_t file_copy_wchar_t(const wchar_t* current_path, const wchar_t* new_path)
+{
+#if defined(_WIN32_WINNT_WIN8) && defined(_WIN32_WINNT) && (_WIN32_WINNT_WIN8 <= _WIN32_WINNT)
+	return SUCCEEDED(CopyFile2(current_path, new_path, NULL));
+#else
+	return 0 != CopyFileExW(current_path, new_path, NULL, NULL, FALSE, COPY_FILE_FAIL_IF_EXISTS);
+#endif
+}
+#endif
+#if !defined(_WIN32)
+uint8_t file_copy_by_descriptors(int input, int output)
+{
+	ssize_t count = 0;
+#if defined(FILE_SYSTEM_COPY_FILE_RANGE) || defined(__linux__)
+	ssize_t copied = 0;
+#endif
+#if defined(FICLONE)
+
+	/*NOTE: on file systems with copy on write support file share extents with the source.*/
+	if (0 == ioctl(output, FICLONE, input))
+	{
+		return 1;
+	}
+
+#endif
+#if defined(FILE_SYSTEM_COPY_FILE_RANGE)
+
+	while (0 < (count = copy_file_range(input, NULL, output, NULL, (size_t)INT32_MAX + 1, 0)) ||
+		   (-1 == count && EINTR == errno))
+	{
+		copied += 0 < count ? count : 0;
+	}
+
+	/*NOTE: entries like ones from procfs or sysfs report zero at the first call, so nothing copied mean try next way.*/
+	if (0 == count && 0 < copied)
+	{
+		return 1;
+	}
+
+	if (-1 == count &&
+		EXDEV != errno && ENOSYS != errno && EINVAL != errno && EOPNOTSUPP != errno)
+	{
+		return 0;
+	}
+
+#endif
+#if defined(__linux__)
+
+	while (0 < (count = sendfile(output, input, NULL, (size_t)INT32_MAX + 1)) ||
+		   (-1 == count && EINTR == errno))
+	{
+		copied += 0 < count ? count : 0;
+	}
+
+	if (0 == count && 0 < copied)
+	{
+		return 1;
+	}
+
+	if (-1 == count &&
+		ENOSYS != errno && EINVAL != errno)
+	{
+		return 0;
+	}
+
+#endif
+	/*NOTE: file offsets already moved by the ways above, so copy continue from the same place.*/
+	uint8_t content_buffer[BUFFER_SIZE_OF];
+	void* content = (void*)content_buffer;
+
+	if (!buffer_init(content, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	if (!buffer_resize(content, 1024 * 1024))
+	{
+		buffer_release(content);
+		return 0;
+	}
+
+	uint8_t* content_ = buffer_uint8_t_data(content, 0);
+
+	while (0 != (count = read(input, content_, buffer_size(content))))
 	{
-		file_close(file);
-		return 0;
-	}
+		if (-1 == count)
+		{
+			if (EINTR == errno)
+			{
+				continue;
+			}
 
-	return file_close(file);
-}
+			break;
+		}
 
-uint8_t file_close(void* stream)
-{
-	return NULL != stream &&
-		   0 == fclose((FILE*)stream);
-}
-#if defined(_WIN32)
-uint8_t file_copy_wchar_t(const wchar_t* current_path, const wchar_t* new_path)
-{
-#if defined(_WIN32_WINNT_WIN8) && defined(_WIN32_WINNT) && (_WIN32_WINNT_WIN8 <= _WIN32_WINNT)
-	return SUCCEEDED(CopyFile2(current_path, new_path, NULL));
-#else
-	return 0 != CopyFileExW(current_path, new_path, NULL, NULL, FALSE, COPY_FILE_FAIL_IF_EXISTS);
-#endif
+		const uint8_t* pos = content_;
+
+		while (0 < count)
+		{
+			const ssize_t written = write(output, pos, count);
+
+			if (-1 == written)
+			{
+				if (EINTR == errno)
+				{
+					continue;
+				}
+
+				buffer_release(content);
+				return 0;
+			}
+
+			pos += written;
+			count -= written;
+		}
+	}
+
+	buffer_release(content);
+	return 0 == count;
 }
 #endif
-uint8_t file_copy(const uint8_t* exists_file, const uint8_t* new_file)
+uint8_t file_copy_with_attributes(
+	const uint8_t* exists_file, const uint8_t* new_file, uint8_t preserve_attributes)
 {
 	if (NULL == exists_file ||
 		NULL == new_file)
@@ -1450,6 +2850,8 @@ uint8_t file_copy(const uint8_t* exists_file, const uint8_t* new_file)
 	}
 
 #if defined(_WIN32)
+	/*NOTE: CopyFile always keep attributes and time of last modification.*/
+	(void)preserve_attributes;
 	uint8_t pathW_buffer[BUFFER_SIZE_OF];
 	void* pathW = (void*)pathW_buffer;
 
@@ -1504,59 +2906,59 @@ uint8_t file_copy(const uint8_t* exists_file, const uint8_t* new_file)
 		return 0;
 	}
 
-	void* input = NULL;
+	const int input = open((const char*)exists_file, O_RDONLY | O_CLOEXEC);
 
-	if (!file_open(exists_file, (const uint8_t*)"rb", &input))
+	if (-1 == input)
 	{
 		return 0;
 	}
 
-	uint8_t content_buffer[BUFFER_SIZE_OF];
-	void* content = (void*)content_buffer;
-
-	if (!buffer_init(content, BUFFER_SIZE_OF))
-	{
-		file_close(input);
-		return 0;
-	}
+	struct stat status;
 
-	if (!buffer_resize(content, 4096))
+	if (-1 == fstat(input, &status))
 	{
-		buffer_release(content);
-		file_close(input);
+		close(input);
 		return 0;
 	}
 
-	void* output = NULL;
+	const int output = open((const char*)new_file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
 
-	if (!file_open(new_file, (const uint8_t*)"wb", &output))
+	if (-1 == output)
 	{
-		buffer_release(content);
-		file_close(input);
+		close(input);
 		return 0;
 	}
 
-	size_t size = 0;
-	void* content_ = buffer_data(content, 0);
+	uint8_t result = file_copy_by_descriptors(input, output);
 
-	while (0 < (size = file_read(content_, sizeof(uint8_t), 4096, input)))
+	if (result && preserve_attributes)
 	{
-		if (size != file_write(content_, sizeof(uint8_t), size, output))
-		{
-			file_close(input);
-			file_close(output);
-			buffer_release(content);
-			return 0;
-		}
+		/*NOTE: only time of last modification is kept when value is FILE_COPY_PRESERVE_LAST_WRITE_TIME.*/
+		struct timespec times[2];
+#if defined(__APPLE__)
+		times[0] = status.st_atimespec;
+		times[1] = status.st_mtimespec;
+#else
+		times[0] = status.st_atim;
+		times[1] = status.st_mtim;
+#endif
+		result = (FILE_COPY_PRESERVE_LAST_WRITE_TIME == preserve_attributes ||
+				  0 == fchmod(output, status.st_mode & 07777)) &&
+				 0 == futimens(output, times);
 	}
 
-	buffer_release(content);
-	size = file_close(input);
-	size = size && file_close(output);
-	return 0 < size && file_get_length(exists_file) == file_get_length(new_file);
+	result = (0 == close(input)) && result;
+	result = (0 == close(output)) && result;
+	file_system_stat_cache_invalidate(new_file, 0);
+	return result;
 #endif
 }
 
+uint8_t file_copy(const uint8_t* exists_file, const uint8_t* new_file)
+{
+	return file_copy_with_attributes(exists_file, new_file, 0);
+}
+
 uint8_t file_create(const uint8_t* path)
 {
 	void* stream = NULL;
@@ -1595,7 +2997,14 @@ uint8_t file_delete(const uint8_t* path)
 	buffer_release(pathW);
 	return returned;
 #else
-	return 0 == remove((const char*)path);
+	/*NOTE: nodes are taken before the removal to refresh other spellings of the path.*/
+	struct file_system_stat_cache_nodes nodes;
+	file_system_stat_cache_get_nodes(path, &nodes);
+	/**/
+	const uint8_t returned = 0 == remove((const char*)path);
+	file_system_stat_cache_invalidate(path, 0);
+	file_system_stat_cache_invalidate_nodes(&nodes);
+	return returned;
 #endif
 }
 #if defined(_WIN32)
@@ -1641,7 +3050,7 @@ uint8_t file_exists(const uint8_t* path)
 #else
 	struct stat file_status;
 	file_status.st_mode = 0;
-	return -1 != stat((const char*)path, &file_status) && (S_IFDIR != (file_status.st_mode & S_IFDIR));
+	return file_system_stat(path, &file_status) && (S_IFDIR != (file_status.st_mode & S_IFDIR));
 #endif
 }
 
@@ -1650,14 +3059,22 @@ uint8_t file_flush(void* stream)
 	return NULL != stream && 0 == fflush((FILE*)stream);
 }
 
-uint8_t file_seek(void* stream, long offset, int32_t origin)
+uint8_t file_seek(void* stream, int64_t offset, int32_t origin)
 {
-	return NULL != stream && 0 == fseek((FILE*)stream, offset, origin);
+#if defined(_WIN32)
+	return NULL != stream && 0 == _fseeki64((FILE*)stream, offset, origin);
+#else
+	return NULL != stream && 0 == fseeko((FILE*)stream, (off_t)offset, origin);
+#endif
 }
 
-long file_tell(void* stream)
+int64_t file_tell(void* stream)
 {
-	return NULL != stream ? ftell((FILE*)stream) : 0;
+#if defined(_WIN32)
+	return NULL != stream ? _ftelli64((FILE*)stream) : 0;
+#else
+	return NULL != stream ? (int64_t)ftello((FILE*)stream) : 0;
+#endif
 }
 
 size_t file_write(const void* content, const size_t size_of_content_element,
@@ -1799,6 +3216,34 @@ int64_t file_get_last_write_time_utc(const uint8_t* path)
 	return file_status.st_mtime;
 #endif
 }
+
+int64_t file_get_last_write_time_precise(const uint8_t* path)
+{
+	if (NULL == path)
+	{
+		return 0;
+	}
+
+	/*NOTE: units depend on the platform, so value can be only compared with other such value.*/
+#if defined(_WIN32)
+	FIND_FILE_OBJECT_DATA_FROM_BUFFER(path);
+	const uint8_t is_file = (0 == (file_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY));
+
+	if (!is_file)
+	{
+		return 0;
+	}
+
+	return ((int64_t)file_data.ftLastWriteTime.dwHighDateTime << 32) + file_data.ftLastWriteTime.dwLowDateTime;
+#else
+	FILE_STAT(path);
+#if defined(__APPLE__)
+	return (int64_t)file_status.st_mtimespec.tv_sec * 1000000000 + file_status.st_mtimespec.tv_nsec;
+#else
+	return (int64_t)file_status.st_mtim.tv_sec * 1000000000 + file_status.st_mtim.tv_nsec;
+#endif
+#endif
+}
 #if defined(_WIN32)
 uint8_t file_open_wchar_t(const wchar_t* path, const wchar_t* mode, void** output)
 {
@@ -1877,7 +3322,15 @@ uint8_t file_move(const uint8_t* current_path, const uint8_t* new_path)
 		return 0;
 	}
 
-	return file_system_move_entry(current_path, new_path);
+	/*NOTE: entry that will be replaced at the new path is refreshed by the nodes taken before.*/
+	struct file_system_stat_cache_nodes nodes;
+	file_system_stat_cache_get_nodes(new_path, &nodes);
+	/**/
+	const uint8_t returned = file_system_move_entry(current_path, new_path);
+	file_system_stat_cache_invalidate(current_path, 0);
+	file_system_stat_cache_invalidate(new_path, 0);
+	file_system_stat_cache_invalidate_nodes(&nodes);
+	return returned;
 #endif
 }
 
@@ -1920,11 +3373,22 @@ uint8_t file_open(const uint8_t* path, const uint8_t* mode, void** output)
 	return returned;
 #else
 #if __STDC_LIB_EXT1__
-	return (0 == fopen_s((FILE**)output, (const char*)path, (const char*)mode) && NULL != *output);
+	const uint8_t returned = (0 == fopen_s((FILE**)output, (const char*)path, (const char*)mode) && NULL != *output);
 #else
 	*output = (void*)fopen((const char*)path, (const char*)mode);
-	return NULL != *output;
+	const uint8_t returned = NULL != *output;
 #endif
+
+	static const uint8_t* write_modes = (const uint8_t*)"wa+";
+	const uint8_t* mode_finish = mode + common_count_bytes_until(mode, zero);
+
+	if (mode_finish != string_find_any_symbol_like_or_not_like_that(
+			mode, mode_finish, write_modes, write_modes + 3, 1, 1))
+	{
+		file_system_stat_cache_invalidate(path, 0);
+	}
+
+	return returned;
 #endif
 }
 
@@ -1944,6 +3408,29 @@ size_t file_read(void* content, const size_t size_of_content_element,
 #endif
 }
 
+int64_t file_get_length_until_end(void* stream)
+{
+#if defined(_WIN32)
+	const int descriptor = _fileno((FILE*)stream);
+	const int64_t length = _filelengthi64(descriptor);
+	const int64_t position = file_tell(stream);
+	/**/
+	return (length < 0 || position < 0 || length < position) ? -1 : length - position;
+#else
+	struct stat status;
+
+	if (0 != fstat(fileno((FILE*)stream), &status) ||
+		!S_ISREG(status.st_mode))
+	{
+		return -1;
+	}
+
+	const int64_t position = file_tell(stream);
+	/**/
+	return (position < 0 || (int64_t)status.st_size < position) ? -1 : (int64_t)status.st_size - position;
+#endif
+}
+
 uint8_t file_read_with_several_steps(void* stream, void* content)
 {
 	if (NULL == stream ||
@@ -1953,29 +3440,40 @@ uint8_t file_read_with_several_steps(void* stream, void* content)
 	}
 
 	ptrdiff_t size = buffer_size(content);
+	ptrdiff_t step = 4096;
+	/*NOTE: rest of the regular file read at once, one more byte allow to see the end of file without one more step.*/
+	const int64_t length = file_get_length_until_end(stream);
 
-	if (!buffer_append(content, NULL, 4096))
+	if (0 < length &&
+		length < (int64_t)(PTRDIFF_MAX - size - 1))
 	{
-		return 0;
+		step = (ptrdiff_t)length + 1;
 	}
 
-	size_t readed = 0;
-	void* content_ = buffer_data(content, size);
-
-	while (0 < (readed = file_read(content_, sizeof(uint8_t), 4096, stream)))
+	while (1)
 	{
+		if (!buffer_append(content, NULL, step))
+		{
+			return 0;
+		}
+
+		const size_t readed = file_read(buffer_data(content, size), sizeof(uint8_t), (size_t)step, stream);
 		size += (ptrdiff_t)readed;
 
-		if (!buffer_resize(content, size) ||
-			(4096 == readed && !buffer_append(content, NULL, 4096)))
+		if (!buffer_resize(content, size))
 		{
 			return 0;
 		}
 
-		content_ = buffer_data(content, size);
+		if (readed < (size_t)step)
+		{
+			break;
+		}
+
+		step = 4096;
 	}
 
-	return buffer_resize(content, size);
+	return 1;
 }
 
 uint8_t file_read_all(const uint8_t* path, void* output)
@@ -2335,7 +3833,9 @@ uint8_t file_set_time_utc(const uint8_t* path, int64_t time, uint8_t function)
 		return 0;
 	}
 
-	return 0 == utime((const char*)path, &times);
+	const uint8_t returned = 0 == utime((const char*)path, &times);
+	file_system_stat_cache_invalidate(path, 0);
+	return returned;
 }
 
 uint8_t file_set_time(const uint8_t* path, int64_t time, uint8_t function)
@@ -2501,180 +4001,320 @@ uint8_t file_write_with_encoding(const struct range* data, uint16_t encoding, vo
 	return 1;
 }
 
-uint8_t file_replace_with_same_length(
-	uint8_t* content, ptrdiff_t size, void* stream,
-	const uint8_t* to_be_replaced, const uint8_t* by_replacement, ptrdiff_t length)
+#define FILE_REPLACE_CHUNK_SIZE 65536
+
+uint8_t file_replace_copy_back(const uint8_t* temporary_path, const uint8_t* path, void* content)
 {
+	void* input = NULL;
+
+	if (!file_open(temporary_path, (const uint8_t*)"rb", &input))
+	{
+		return 0;
+	}
+
+	void* output = NULL;
+
+	/*NOTE: original file truncated and written through its path, so links, owner and mode are kept.*/
+	if (!file_open(path, (const uint8_t*)"wb", &output))
+	{
+		file_close(input);
+		return 0;
+	}
+
+	uint8_t result = buffer_resize(content, FILE_REPLACE_CHUNK_SIZE);
+	uint8_t* data = buffer_uint8_t_data(content, 0);
 	ptrdiff_t readed = 0;
 
-	while (0 < (readed = file_read(content, sizeof(uint8_t), size, stream)))
+	while (result &&
+		   0 < (readed = (ptrdiff_t)file_read(data, sizeof(uint8_t), FILE_REPLACE_CHUNK_SIZE, input)))
 	{
-		const uint8_t* start = content;
-		const uint8_t* finish = content + readed;
+		result = readed == (ptrdiff_t)file_write(data, sizeof(uint8_t), readed, output);
+	}
 
-		while (NULL != start && length <= finish - start)
-		{
-			if (0 != memcmp(start, to_be_replaced, length))
-			{
-				start = string_enumerate(start, finish, NULL);
-				continue;
-			}
+	result = file_close(output) && result;
+	result = file_close(input) && result;
+	return result;
+}
+
+uint8_t file_replace_in_window(
+	uint8_t* window, ptrdiff_t filled, ptrdiff_t limit,
+	const struct range* pairs, ptrdiff_t count, const ptrdiff_t* shifts, ptrdiff_t* next,
+	void* output, ptrdiff_t* modified_start, ptrdiff_t* modified_finish, ptrdiff_t* position)
+{
+	const uint8_t* finish = window + filled;
+	ptrdiff_t pos = 0;
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		next[i] = -1;
+	}
 
-			long index = (long)((start - content) - readed);
+	while (1)
+	{
+		ptrdiff_t pair = -1;
 
-			if (!file_seek(stream, index, SEEK_CUR))
+		for (ptrdiff_t i = 0; i < count; ++i)
+		{
+			if (-1 < next[i] && next[i] < pos)
 			{
-				return 0;
+				next[i] = -1;
 			}
 
-			if (length != (ptrdiff_t)fwrite(by_replacement, sizeof(uint8_t), length, (FILE*)stream))
+			if (-1 == next[i])
 			{
-				return 0;
+				const uint8_t* found = string_horspool_find(
+										   window + pos, finish, pairs[2 * i].start, pairs[2 * i].finish, shifts + 256 * i);
+				next[i] = NULL == found ? filled : found - window;
 			}
 
-			index = (long)(readed - (start - content) - length);
-
-			if (!file_seek(stream, index, SEEK_CUR))
+			if (next[i] < limit &&
+				(-1 == pair || next[i] < next[pair]))
 			{
-				return 0;
+				pair = i;
 			}
-
-			start += length;
 		}
 
-		if (readed < size)
+		if (-1 == pair)
 		{
 			break;
 		}
 
-		if (length < size)
+		const struct range* to_be_replaced = &pairs[2 * pair];
+		const struct range* by_replacement = &pairs[2 * pair + 1];
+		const ptrdiff_t to_be_replaced_length = to_be_replaced->finish - to_be_replaced->start;
+		const ptrdiff_t by_replacement_length =
+			(NULL == by_replacement->start || by_replacement->finish < by_replacement->start) ?
+			0 : by_replacement->finish - by_replacement->start;
+		const ptrdiff_t index = next[pair];
+
+		if (NULL == output)
 		{
-			if (!file_seek(stream, (long)(-length), SEEK_CUR))
-			{
-				return 0;
-			}
+			/*NOTE: lengths are same, replacement written over the data at the window.*/
+			memcpy(window + index, by_replacement->start, by_replacement_length);
+			*modified_start = -1 == *modified_start ? index : *modified_start;
+			*modified_finish = index + to_be_replaced_length;
+		}
+		else if (!buffer_append(output, window + pos, index - pos) ||
+				 !buffer_append(output, by_replacement->start, by_replacement_length))
+		{
+			return 0;
 		}
+
+		pos = index + to_be_replaced_length;
+	}
+
+	const ptrdiff_t carry_start = MAX(pos, limit);
+
+	if (NULL != output &&
+		!buffer_append(output, window + pos, carry_start - pos))
+	{
+		return 0;
 	}
 
+	*position = carry_start;
 	return 1;
 }
 
-uint8_t file_replace(const uint8_t* path,
-					 const uint8_t* to_be_replaced_start, const uint8_t* to_be_replaced_finish,
-					 const uint8_t* by_replacement_start, const uint8_t* by_replacement_finish)
+uint8_t file_replace_in_pairs(const uint8_t* path, const struct range* pairs, ptrdiff_t count)
 {
-	if (NULL == to_be_replaced_start || NULL == to_be_replaced_finish ||
-		to_be_replaced_finish <= to_be_replaced_start)
+	if (NULL == path ||
+		NULL == pairs ||
+		count < 1)
 	{
 		return 0;
 	}
 
+	ptrdiff_t max_length = 0;
+	uint8_t is_same_length = 1;
+	uint8_t is_changing = 0;
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		const struct range* to_be_replaced = &pairs[2 * i];
+		const struct range* by_replacement = &pairs[2 * i + 1];
+
+		if (range_is_null_or_empty(to_be_replaced))
+		{
+			return 0;
+		}
+
+		const ptrdiff_t length = to_be_replaced->finish - to_be_replaced->start;
+		max_length = MAX(max_length, length);
+		/**/
+		is_same_length = is_same_length && NULL != by_replacement->start &&
+						 length == by_replacement->finish - by_replacement->start;
+		is_changing = is_changing ||
+					  !string_equal(to_be_replaced->start, to_be_replaced->finish,
+									by_replacement->start, by_replacement->finish);
+	}
+
 	void* stream = NULL;
 
-	if (!file_open(path, (const uint8_t*)"rb+", &stream))
+	if (!file_open(path, is_same_length ? (const uint8_t*)"rb+" : (const uint8_t*)"rb", &stream))
 	{
 		return 0;
 	}
 
-	if (string_equal(to_be_replaced_start, to_be_replaced_finish, by_replacement_start, by_replacement_finish))
+	if (!is_changing)
 	{
 		return file_close(stream);
 	}
 
-	const ptrdiff_t to_be_replaced_length = to_be_replaced_finish - to_be_replaced_start;
-	const ptrdiff_t by_replacement_length = (NULL == by_replacement_start || NULL == by_replacement_finish ||
-											by_replacement_finish < by_replacement_start) ? -1 : (by_replacement_finish - by_replacement_start);
-	const ptrdiff_t size = MAX(by_replacement_length, MAX(to_be_replaced_length, 4096));
-	/**/
-	uint8_t input_buffer[BUFFER_SIZE_OF];
-	void* input = (void*)input_buffer;
+	uint8_t content_buffer[BUFFER_SIZE_OF];
+	void* content = (void*)content_buffer;
 
-	if (!buffer_init(input, BUFFER_SIZE_OF))
+	if (!buffer_init(content, BUFFER_SIZE_OF))
 	{
-		fclose((FILE*)stream);
+		file_close(stream);
 		return 0;
 	}
 
-	if (!buffer_resize(input, size))
+	const ptrdiff_t window_size = FILE_REPLACE_CHUNK_SIZE + max_length;
+	const ptrdiff_t shifts_size = 256 * count * sizeof(ptrdiff_t);
+
+	if (!buffer_append(content, NULL, window_size + shifts_size + count * (ptrdiff_t)sizeof(ptrdiff_t)))
 	{
-		buffer_release(input);
-		fclose((FILE*)stream);
+		buffer_release(content);
+		file_close(stream);
 		return 0;
 	}
 
-	uint8_t* content = buffer_uint8_t_data(input, 0);
+	uint8_t* window = buffer_uint8_t_data(content, 0);
+	ptrdiff_t* shifts = (ptrdiff_t*)buffer_data(content, window_size);
+	ptrdiff_t* next = (ptrdiff_t*)buffer_data(content, window_size + shifts_size);
 
-	if (to_be_replaced_length == by_replacement_length)
+	for (ptrdiff_t i = 0; i < count; ++i)
 	{
-		if (!file_replace_with_same_length(content, size, stream,
-										   to_be_replaced_start, by_replacement_start, to_be_replaced_length))
-		{
-			buffer_release(input);
-			file_close(stream);
-			return 0;
-		}
+		string_horspool_table(pairs[2 * i].start, pairs[2 * i].finish, shifts + 256 * i);
 	}
-	else
+
+	uint8_t output_buffer[BUFFER_SIZE_OF];
+	void* output = (void*)output_buffer;
+	void* output_stream = NULL;
+
+	if (!buffer_init(output, BUFFER_SIZE_OF))
+	{
+		buffer_release(content);
+		file_close(stream);
+		return 0;
+	}
+
+	if (!is_same_length)
 	{
-		/*TODO:*/
-		if (!buffer_resize(input, 0) ||
-			!file_read_with_several_steps(stream, input))
+		/*NOTE: result written into the temporary file near the original one, that than copied back.
+		  Existing file with such name is not overwritten.*/
+		if (!buffer_append(output, path, common_count_bytes_until(path, 0)) ||
+			!buffer_append_char(output, ".replace.tmp", 13) ||
+			!file_open(buffer_uint8_t_data(output, 0), (const uint8_t*)"wbx", &output_stream))
 		{
-			buffer_release(input);
+			buffer_release(output);
+			buffer_release(content);
 			file_close(stream);
 			return 0;
 		}
 
-		if (!file_close(stream))
+		if (!buffer_append_data_from_buffer(content, output) ||
+			!buffer_resize(output, 0))
 		{
-			buffer_release(input);
+			file_close(output_stream);
+			buffer_release(output);
+			buffer_release(content);
+			file_close(stream);
 			return 0;
 		}
 
-		uint8_t output_buffer[BUFFER_SIZE_OF];
-		void* output = (void*)output_buffer;
+		window = buffer_uint8_t_data(content, 0);
+		shifts = (ptrdiff_t*)buffer_data(content, window_size);
+		next = (ptrdiff_t*)buffer_data(content, window_size + shifts_size);
+	}
 
-		if (!buffer_init(output, BUFFER_SIZE_OF))
+	ptrdiff_t filled = 0;
+	int64_t base = 0;
+	uint8_t result = 1;
+
+	while (result)
+	{
+		const ptrdiff_t readed = (ptrdiff_t)file_read(window + filled, sizeof(uint8_t), FILE_REPLACE_CHUNK_SIZE, stream);
+		const uint8_t is_end = readed < FILE_REPLACE_CHUNK_SIZE;
+		filled += readed;
+		/*NOTE: matches that can be cut by the end of the window are searched at the next step.*/
+		const ptrdiff_t limit = is_end ? filled : MAX(0, filled - (max_length - 1));
+		ptrdiff_t modified_start = -1;
+		ptrdiff_t modified_finish = -1;
+		ptrdiff_t position = 0;
+		/**/
+		result = file_replace_in_window(
+					 window, filled, limit, pairs, count, shifts, next,
+					 is_same_length ? NULL : output, &modified_start, &modified_finish, &position);
+
+		if (!result)
 		{
-			buffer_release(input);
-			return 0;
+			break;
 		}
 
-		struct range input_in_range;
-
-		BUFFER_TO_RANGE(input_in_range, input);
-
-		if (!string_replace(input_in_range.start, input_in_range.finish,
-							to_be_replaced_start, to_be_replaced_finish,
-							by_replacement_start, by_replacement_finish, output))
+		if (is_same_length)
 		{
-			buffer_release(input);
-			buffer_release(output);
-			return 0;
+			if (-1 < modified_start)
+			{
+				result = file_seek(stream, base + modified_start, SEEK_SET) &&
+						 modified_finish - modified_start ==
+						 (ptrdiff_t)file_write(window + modified_start, sizeof(uint8_t),
+											   modified_finish - modified_start, stream) &&
+						 file_seek(stream, base + filled, SEEK_SET);
+			}
 		}
-
-		buffer_release(input);
-		stream = NULL;
-
-		if (!file_open(path, (const uint8_t*)"wb", &stream))
+		else if (is_end || FILE_REPLACE_CHUNK_SIZE <= buffer_size(output))
 		{
-			buffer_release(output);
-			return 0;
+			result = file_write_with_several_steps(output, output_stream) &&
+					 buffer_resize(output, 0);
 		}
 
-		if (!file_write_with_several_steps(output, stream))
+		if (is_end)
 		{
-			buffer_release(output);
-			file_close(stream);
-			return 0;
+			break;
 		}
 
+		filled -= position;
+		memmove(window, window + position, filled);
+		base += position;
+	}
+
+	if (is_same_length)
+	{
+		result = file_close(stream) && result;
 		buffer_release(output);
-		return file_close(stream);
+		buffer_release(content);
+		return result;
 	}
 
-	buffer_release(input);
-	return file_close(stream);
+	file_close(stream);
+	const uint8_t* temporary_path = buffer_uint8_t_data(
+										 content, window_size + shifts_size + count * (ptrdiff_t)sizeof(ptrdiff_t));
+	const uint8_t is_written = file_close(output_stream) && result;
+	result = is_written && file_replace_copy_back(temporary_path, path, output);
+
+	/*NOTE: if copy back failed, the only full result is at the temporary file, so it kept.*/
+	if (result || !is_written)
+	{
+		file_delete(temporary_path);
+	}
+
+	buffer_release(output);
+	buffer_release(content);
+	return result;
+}
+
+uint8_t file_replace(const uint8_t* path,
+					 const uint8_t* to_be_replaced_start, const uint8_t* to_be_replaced_finish,
+					 const uint8_t* by_replacement_start, const uint8_t* by_replacement_finish)
+{
+	struct range pairs[2];
+	pairs[0].start = to_be_replaced_start;
+	pairs[0].finish = to_be_replaced_finish;
+	pairs[1].start = by_replacement_start;
+	pairs[1].finish = by_replacement_finish;
+	/**/
+	return file_replace_in_pairs(path, pairs, 1);
 }
 
 uint8_t file_get_full_path(
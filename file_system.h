@@ -28,12 +28,18 @@ uint8_t file_system_path_in_range_to_pathW(
 uint8_t file_system_path_to_pathW(const uint8_t* path, void* pathW);
 #endif
 
+uint8_t file_system_set_stat_cache(uint8_t enable);
+void file_system_stat_cache_invalidate(const uint8_t* path, uint8_t with_content);
+void file_system_get_stat_cache_statistics(ptrdiff_t* saved, ptrdiff_t* performed);
+void file_system_release_stat_cache();
+
 uint8_t directory_create(const uint8_t* path);
 uint8_t directory_delete(const uint8_t* path);
+uint8_t directory_delete_with_threads(const uint8_t* path, uint16_t threads, void* failures);
 
 uint8_t directory_enumerate_file_system_entries(
-	void* path, const uint8_t entry_type, const uint8_t recurse,
-	void* output, uint8_t fail_on_error);
+	void* path, const uint8_t entry_type, const uint8_t recurse, const void* exclude,
+	void* output, uint8_t fail_on_error, uint16_t threads);
 
 #if defined(_WIN32)
 uint8_t directory_exists_wchar_t(const wchar_t* path);
@@ -66,6 +72,10 @@ uint8_t file_append(
 	const uint8_t* path, const struct range* data, uint16_t encoding);
 uint8_t file_close(void* stream);
 uint8_t file_copy(const uint8_t* exists_file, const uint8_t* new_file);
+#define FILE_COPY_PRESERVE_LAST_WRITE_TIME	2
+
+uint8_t file_copy_with_attributes(
+	const uint8_t* exists_file, const uint8_t* new_file, uint8_t preserve_attributes);
 uint8_t file_create(const uint8_t* path);
 uint8_t file_delete(const uint8_t* path);
 
@@ -84,6 +94,7 @@ int64_t file_get_last_access_time(const uint8_t* path);
 int64_t file_get_last_access_time_utc(const uint8_t* path);
 int64_t file_get_last_write_time(const uint8_t* path);
 int64_t file_get_last_write_time_utc(const uint8_t* path);
+int64_t file_get_last_write_time_precise(const uint8_t* path);
 
 uint64_t file_get_length(const uint8_t* path);
 uint8_t file_move(const uint8_t* current_path, const uint8_t* new_path);
@@ -100,7 +111,10 @@ uint8_t file_replace(
 	const uint8_t* to_be_replaced_start, const uint8_t* to_be_replaced_finish,
 	const uint8_t* by_replacement_start, const uint8_t* by_replacement_finish);
 
-uint8_t file_seek(void* stream, long offset, int32_t origin);
+uint8_t file_replace_in_pairs(
+	const uint8_t* path, const struct range* pairs, ptrdiff_t count);
+
+uint8_t file_seek(void* stream, int64_t offset, int32_t origin);
 
 uint8_t file_set_attributes(
 	const uint8_t* path, uint8_t archive, uint8_t hidden,
@@ -113,7 +127,7 @@ uint8_t file_set_last_access_time_utc(const uint8_t* path, int64_t time);
 uint8_t file_set_last_write_time(const uint8_t* path, int64_t time);
 uint8_t file_set_last_write_time_utc(const uint8_t* path, int64_t time);
 
-long file_tell(void* stream);
+int64_t file_tell(void* stream);
 
 uint8_t file_up_to_date(const uint8_t* src_file, const uint8_t* target_file);
 
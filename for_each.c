@@ -135,7 +135,8 @@ uint8_t for_each_with_trim(void* the_project, const void* the_target,
 		return 0;
 	}
 
-	if (!xml_get_sub_nodes_elements(attributes_finish, element_finish, NULL, tmp))
+	if (!xml_get_sub_nodes_elements(
+			project_get_xml_index(the_project), attributes_finish, element_finish, NULL, tmp))
 	{
 		return 1;
 	}
@@ -221,7 +222,7 @@ uint8_t for_each_file_system_entries(void* the_project, const void* the_target,
 		return 0;
 	}
 
-	fail_on_error = directory_enumerate_file_system_entries(input, File == item_value, 0, tmp, fail_on_error);
+	fail_on_error = directory_enumerate_file_system_entries(input, File == item_value, 0, NULL, tmp, fail_on_error, 1);
 
 	if (!fail_on_error)
 	{
@@ -503,7 +504,8 @@ uint8_t do_evaluate_task(
 		return 0;
 	}
 
-	if (xml_get_sub_nodes_elements(attributes_finish, element_finish, NULL, elements))
+	if (xml_get_sub_nodes_elements(
+			project_get_xml_index(the_project), attributes_finish, element_finish, NULL, elements))
 	{
 		return interpreter_evaluate_tasks(the_project, the_target, elements, NULL, 0, verbose);
 	}
@@ -123,7 +123,7 @@ uint8_t BLAKE2b_init(uint8_t hash_length, uint64_t* output)
 	return 1;
 }
 
-uint8_t BLAKE2b_core(const uint8_t* start, const uint8_t* finish, ptrdiff_t* bytes_compressed,
+uint8_t BLAKE2b_core(const uint8_t* start, const uint8_t* finish, uint64_t* bytes_compressed,
 					 uint64_t* output)
 {
 	if (range_in_parts_is_null_or_empty(start, finish) ||
@@ -155,7 +155,7 @@ uint8_t BLAKE2b_core(const uint8_t* start, const uint8_t* finish, ptrdiff_t* byt
 	return 1;
 }
 
-uint8_t BLAKE2b_final(const uint8_t* start, ptrdiff_t* bytes_compressed, uint8_t bytes_remaining,
+uint8_t BLAKE2b_final(const uint8_t* start, uint64_t* bytes_compressed, uint8_t bytes_remaining,
 					  uint64_t* output)
 {
 	if (NULL == start ||
@@ -218,7 +218,7 @@ uint8_t BLAKE2b(const uint8_t* start, const uint8_t* finish,
 		return 0;
 	}
 
-	ptrdiff_t bytes_compressed = 0;
+	uint64_t bytes_compressed = 0;
 
 	while (start + 128 < finish)
 	{
@@ -15,10 +15,22 @@
 
 #include "hash.h"
 #include "buffer.h"
+#include "common.h"
+#include "thread.h"
 
 #include <stddef.h>
 #include <string.h>
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BLAKE3_X86
+#define BLAKE3_TARGET(NAME) __attribute__((target(NAME)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define BLAKE3_X86
+#define BLAKE3_TARGET(NAME)
+#include <intrin.h>
+#endif
+
 static const uint32_t IV[] =
 {
 	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
@@ -36,6 +48,18 @@ enum BLAKE3_DOMAIN_FLAGS
 #define BLAKE3_CHUNK_LENGTH (uint16_t)1024
 #define BLAKE3_OUTPUT_LENGTH (uint8_t)(8 * sizeof(uint32_t))
 #define BLAKE3_MAXIMUM_CHUNKS_COUNT (uint8_t)24
+#define BLAKE3_CHUNKS_PER_JOB (ptrdiff_t)64
+
+static const uint8_t SIGMA[7][16] =
+{
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+	{ 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+	{ 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+	{ 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+	{ 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+	{ 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 }
+};
 
 #define ROTATE_RIGHT_UINT32_T(VALUE, OFFSET)			\
 	((VALUE) >> (OFFSET)) | (VALUE) << (32 - (OFFSET))
@@ -63,17 +87,6 @@ enum BLAKE3_DOMAIN_FLAGS
 uint8_t BLAKE3_compress(const uint32_t* h, const uint32_t* m, const uint32_t* t,
 						uint32_t b, uint32_t d, uint32_t* V)
 {
-	static const uint8_t SIGMA[7][16] =
-	{
-		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
-		{ 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
-		{ 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
-		{ 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
-		{ 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
-		{ 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
-		{ 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 }
-	};
-
 	if (NULL == h ||
 		NULL == m ||
 		NULL == t ||
@@ -170,31 +183,314 @@ uint8_t BLAKE3_hash_input(uint8_t d, const uint32_t* m, const uint32_t* t, uint3
 	return 1;
 }
 
-uint8_t BLAKE3_hash_inputs(uint8_t d, const uint8_t** inputs, uint8_t count_of_inputs, const uint32_t* t,
+#if defined(BLAKE3_X86)
+/*NOTE: each lane of the vector hold the state of own chunk, chunks are compressed side by side.*/
+#define BLAKE3_MIX_LANES(ADD, XOR, ROTATE_16, ROTATE_12, ROTATE_8, ROTATE_7, VA, VB, VC, VD, X, Y)	\
+	(VA) = ADD(ADD((VA), (VB)), (X));																\
+	(VD) = ROTATE_16(XOR((VD), (VA)));																\
+	(VC) = ADD((VC), (VD));																		\
+	(VB) = ROTATE_12(XOR((VB), (VC)));																\
+	(VA) = ADD(ADD((VA), (VB)), (Y));																\
+	(VD) = ROTATE_8(XOR((VD), (VA)));																\
+	(VC) = ADD((VC), (VD));																		\
+	(VB) = ROTATE_7(XOR((VB), (VC)));
+
+#define BLAKE3_ROUND_LANES(MIX, V, M, S)								\
+	MIX((V)[0], (V)[4], (V)[8], (V)[12], (M)[(S)[0]], (M)[(S)[1]]);		\
+	MIX((V)[1], (V)[5], (V)[9], (V)[13], (M)[(S)[2]], (M)[(S)[3]]);		\
+	MIX((V)[2], (V)[6], (V)[10], (V)[14], (M)[(S)[4]], (M)[(S)[5]]);		\
+	MIX((V)[3], (V)[7], (V)[11], (V)[15], (M)[(S)[6]], (M)[(S)[7]]);		\
+	MIX((V)[0], (V)[5], (V)[10], (V)[15], (M)[(S)[8]], (M)[(S)[9]]);		\
+	MIX((V)[1], (V)[6], (V)[11], (V)[12], (M)[(S)[10]], (M)[(S)[11]]);	\
+	MIX((V)[2], (V)[7], (V)[8], (V)[13], (M)[(S)[12]], (M)[(S)[13]]);		\
+	MIX((V)[3], (V)[4], (V)[9], (V)[14], (M)[(S)[14]], (M)[(S)[15]]);
+
+#define BLAKE3_SSE_ROTATE(X, N) _mm_or_si128(_mm_srli_epi32((X), (N)), _mm_slli_epi32((X), 32 - (N)))
+#define BLAKE3_SSE_ROTATE_16(X) _mm_shuffle_epi8((X), _mm_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2))
+#define BLAKE3_SSE_ROTATE_12(X) BLAKE3_SSE_ROTATE((X), 12)
+#define BLAKE3_SSE_ROTATE_8(X) _mm_shuffle_epi8((X), _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1))
+#define BLAKE3_SSE_ROTATE_7(X) BLAKE3_SSE_ROTATE((X), 7)
+
+#define BLAKE3_SSE_MIX(VA, VB, VC, VD, X, Y)									\
+	BLAKE3_MIX_LANES(_mm_add_epi32, _mm_xor_si128,								\
+					 BLAKE3_SSE_ROTATE_16, BLAKE3_SSE_ROTATE_12,				\
+					 BLAKE3_SSE_ROTATE_8, BLAKE3_SSE_ROTATE_7, VA, VB, VC, VD, X, Y)
+
+#define BLAKE3_SSE_TRANSPOSE(R0, R1, R2, R3, O0, O1, O2, O3)	\
+	{															\
+		const __m128i t0 = _mm_unpacklo_epi32((R0), (R1));		\
+		const __m128i t1 = _mm_unpackhi_epi32((R0), (R1));		\
+		const __m128i t2 = _mm_unpacklo_epi32((R2), (R3));		\
+		const __m128i t3 = _mm_unpackhi_epi32((R2), (R3));		\
+		(O0) = _mm_unpacklo_epi64(t0, t2);						\
+		(O1) = _mm_unpackhi_epi64(t0, t2);						\
+		(O2) = _mm_unpacklo_epi64(t1, t3);						\
+		(O3) = _mm_unpackhi_epi64(t1, t3);						\
+	}
+
+BLAKE3_TARGET("sse4.1")
+void BLAKE3_hash_4_chunks(const uint8_t* input, const uint32_t* t, uint8_t d, uint32_t* output)
+{
+	__m128i h[8];
+	__m128i m[16];
+	__m128i V[16];
+	/**/
+	const __m128i counter_low = _mm_setr_epi32(
+									(int)t[0], (int)(t[0] + 1), (int)(t[0] + 2), (int)(t[0] + 3));
+	const __m128i counter_high = _mm_setr_epi32(
+									 (int)t[1], (int)(t[1] + (t[0] + 1 < t[0])),
+									 (int)(t[1] + (t[0] + 2 < t[0])), (int)(t[1] + (t[0] + 3 < t[0])));
+
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		h[i] = _mm_set1_epi32((int)IV[i]);
+	}
+
+	for (uint8_t block = 0; block < 16; ++block)
+	{
+		const uint8_t* ptr = input + block * BLAKE3_BLOCK_LENGTH;
+
+		for (uint8_t i = 0; i < 16; i += 4)
+		{
+			BLAKE3_SSE_TRANSPOSE(
+				_mm_loadu_si128((const __m128i*)(ptr + i * sizeof(uint32_t))),
+				_mm_loadu_si128((const __m128i*)(ptr + BLAKE3_CHUNK_LENGTH + i * sizeof(uint32_t))),
+				_mm_loadu_si128((const __m128i*)(ptr + 2 * BLAKE3_CHUNK_LENGTH + i * sizeof(uint32_t))),
+				_mm_loadu_si128((const __m128i*)(ptr + 3 * BLAKE3_CHUNK_LENGTH + i * sizeof(uint32_t))),
+				m[i], m[i + 1], m[i + 2], m[i + 3]);
+		}
+
+		const uint8_t domain_flags = d | (0 == block ? CHUNK_START : 0) | (15 == block ? CHUNK_END : 0);
+
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			V[i] = h[i];
+		}
+
+		for (uint8_t i = 8; i < 12; ++i)
+		{
+			V[i] = _mm_set1_epi32((int)IV[i - 8]);
+		}
+
+		V[12] = counter_low;
+		V[13] = counter_high;
+		V[14] = _mm_set1_epi32(BLAKE3_BLOCK_LENGTH);
+		V[15] = _mm_set1_epi32(domain_flags);
+
+		for (uint8_t i = 0; i < 7; ++i)
+		{
+			const uint8_t* S = SIGMA[i];
+			BLAKE3_ROUND_LANES(BLAKE3_SSE_MIX, V, m, S);
+		}
+
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			h[i] = _mm_xor_si128(V[i], V[i + 8]);
+		}
+	}
+
+	BLAKE3_SSE_TRANSPOSE(h[0], h[1], h[2], h[3], V[0], V[2], V[4], V[6]);
+	BLAKE3_SSE_TRANSPOSE(h[4], h[5], h[6], h[7], V[1], V[3], V[5], V[7]);
+
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		_mm_storeu_si128((__m128i*)(output + 4 * i), V[i]);
+	}
+}
+
+#define BLAKE3_AVX2_ROTATE(X, N) _mm256_or_si256(_mm256_srli_epi32((X), (N)), _mm256_slli_epi32((X), 32 - (N)))
+#define BLAKE3_AVX2_ROTATE_16(X)																	\
+	_mm256_shuffle_epi8((X), _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,	\
+						13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2))
+#define BLAKE3_AVX2_ROTATE_12(X) BLAKE3_AVX2_ROTATE((X), 12)
+#define BLAKE3_AVX2_ROTATE_8(X)																	\
+	_mm256_shuffle_epi8((X), _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,	\
+						12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1))
+#define BLAKE3_AVX2_ROTATE_7(X) BLAKE3_AVX2_ROTATE((X), 7)
+
+#define BLAKE3_AVX2_MIX(VA, VB, VC, VD, X, Y)									\
+	BLAKE3_MIX_LANES(_mm256_add_epi32, _mm256_xor_si256,						\
+					 BLAKE3_AVX2_ROTATE_16, BLAKE3_AVX2_ROTATE_12,				\
+					 BLAKE3_AVX2_ROTATE_8, BLAKE3_AVX2_ROTATE_7, VA, VB, VC, VD, X, Y)
+
+#define BLAKE3_AVX2_TRANSPOSE(R, O)											\
+	{																		\
+		__m256i t[8];														\
+		__m256i u[8];														\
+		\
+		for (uint8_t j = 0; j < 8; j += 2)									\
+		{																	\
+			t[j] = _mm256_unpacklo_epi32((R)[j], (R)[j + 1]);				\
+			t[j + 1] = _mm256_unpackhi_epi32((R)[j], (R)[j + 1]);			\
+		}																	\
+		\
+		for (uint8_t j = 0; j < 8; j += 4)									\
+		{																	\
+			u[j] = _mm256_unpacklo_epi64(t[j], t[j + 2]);					\
+			u[j + 1] = _mm256_unpackhi_epi64(t[j], t[j + 2]);				\
+			u[j + 2] = _mm256_unpacklo_epi64(t[j + 1], t[j + 3]);			\
+			u[j + 3] = _mm256_unpackhi_epi64(t[j + 1], t[j + 3]);			\
+		}																	\
+		\
+		for (uint8_t j = 0; j < 4; ++j)										\
+		{																	\
+			(O)[j] = _mm256_permute2x128_si256(u[j], u[j + 4], 0x20);		\
+			(O)[j + 4] = _mm256_permute2x128_si256(u[j], u[j + 4], 0x31);	\
+		}																	\
+	}
+
+BLAKE3_TARGET("avx2")
+void BLAKE3_hash_8_chunks(const uint8_t* input, const uint32_t* t, uint8_t d, uint32_t* output)
+{
+	__m256i h[8];
+	__m256i m[16];
+	__m256i V[16];
+	uint32_t counter[2][8];
+
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		counter[0][i] = t[0] + i;
+		counter[1][i] = t[1] + (counter[0][i] < t[0]);
+		h[i] = _mm256_set1_epi32((int)IV[i]);
+	}
+
+	const __m256i counter_low = _mm256_loadu_si256((const __m256i*)counter[0]);
+	const __m256i counter_high = _mm256_loadu_si256((const __m256i*)counter[1]);
+
+	for (uint8_t block = 0; block < 16; ++block)
+	{
+		const uint8_t* ptr = input + block * BLAKE3_BLOCK_LENGTH;
+
+		for (uint8_t i = 0; i < 16; i += 8)
+		{
+			for (uint8_t j = 0; j < 8; ++j)
+			{
+				V[j] = _mm256_loadu_si256(
+						   (const __m256i*)(ptr + j * BLAKE3_CHUNK_LENGTH + i * sizeof(uint32_t)));
+			}
+
+			BLAKE3_AVX2_TRANSPOSE(V, m + i);
+		}
+
+		const uint8_t domain_flags = d | (0 == block ? CHUNK_START : 0) | (15 == block ? CHUNK_END : 0);
+
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			V[i] = h[i];
+		}
+
+		for (uint8_t i = 8; i < 12; ++i)
+		{
+			V[i] = _mm256_set1_epi32((int)IV[i - 8]);
+		}
+
+		V[12] = counter_low;
+		V[13] = counter_high;
+		V[14] = _mm256_set1_epi32(BLAKE3_BLOCK_LENGTH);
+		V[15] = _mm256_set1_epi32(domain_flags);
+
+		for (uint8_t i = 0; i < 7; ++i)
+		{
+			const uint8_t* S = SIGMA[i];
+			BLAKE3_ROUND_LANES(BLAKE3_AVX2_MIX, V, m, S);
+		}
+
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			h[i] = _mm256_xor_si256(V[i], V[i + 8]);
+		}
+	}
+
+	BLAKE3_AVX2_TRANSPOSE(h, V);
+
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)(output + 8 * i), V[i]);
+	}
+}
+
+enum BLAKE3_KERNEL
+{
+	BLAKE3_UNKNOWN_KERNEL, BLAKE3_PORTABLE, BLAKE3_SSE41, BLAKE3_AVX2
+};
+
+static uint8_t blake3_kernel = BLAKE3_UNKNOWN_KERNEL;
+
+uint8_t BLAKE3_get_kernel()
+{
+	if (BLAKE3_UNKNOWN_KERNEL != blake3_kernel)
+	{
+		return blake3_kernel;
+	}
+
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int count = info[0];
+	__cpuid(info, 1);
+	const uint8_t sse41 = 0 != (info[2] & (1 << 19));
+	/*NOTE: AVX registers also should be saved by the operating system.*/
+	const uint8_t avx = 0 != (info[2] & (1 << 27)) && 0 != (info[2] & (1 << 28)) &&
+						6 == (_xgetbv(0) & 6);
+	uint8_t avx2 = 0;
+
+	if (7 <= count)
+	{
+		__cpuidex(info, 7, 0);
+		avx2 = avx && 0 != (info[1] & (1 << 5));
+	}
+
+#else
+	__builtin_cpu_init();
+	const uint8_t sse41 = 0 != __builtin_cpu_supports("sse4.1");
+	const uint8_t avx2 = 0 != __builtin_cpu_supports("avx2");
+#endif
+	blake3_kernel = avx2 ? BLAKE3_AVX2 : (sse41 ? BLAKE3_SSE41 : BLAKE3_PORTABLE);
+	return blake3_kernel;
+}
+#endif
+uint8_t BLAKE3_hash_chunks(uint8_t d, const uint8_t* input, ptrdiff_t count, const uint32_t* t,
 						   uint32_t* h)
 {
-	uint64_t index = 0;
 	uint32_t counter[2];
 	counter[0] = t[0];
 	counter[1] = t[1];
 	uint32_t m[BLAKE3_CHUNK_LENGTH / sizeof(uint32_t)];
+#if defined(BLAKE3_X86)
+	const uint8_t kernel = BLAKE3_get_kernel();
+#endif
 
-	while (0 < count_of_inputs)
+	while (0 < count)
 	{
-		if (!hash_algorithm_uint8_t_array_to_uint32_t_array(inputs[index], BLAKE3_CHUNK_LENGTH, m))
+		uint8_t step = 1;
+#if defined(BLAKE3_X86)
+
+		if (BLAKE3_AVX2 == kernel && 8 <= count)
 		{
-			return 0;
+			BLAKE3_hash_8_chunks(input, counter, d, h);
+			step = 8;
 		}
-
-		if (!BLAKE3_hash_input(d, m, counter,
-							   h + index * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t))))
+		else if (BLAKE3_SSE41 <= kernel && 4 <= count)
 		{
-			return 0;
+			BLAKE3_hash_4_chunks(input, counter, d, h);
+			step = 4;
+		}
+		else
+#endif
+		{
+			/*TODO: NEON kernel.*/
+			if (!hash_algorithm_uint8_t_array_to_uint32_t_array(input, BLAKE3_CHUNK_LENGTH, m) ||
+				!BLAKE3_hash_input(d, m, counter, h))
+			{
+				return 0;
+			}
 		}
 
-		counter[0] += 1;
-		++index;
-		--count_of_inputs;
+		input += (ptrdiff_t)step * BLAKE3_CHUNK_LENGTH;
+		h += (ptrdiff_t)step * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t));
+		count -= step;
+		counter[1] += counter[0] + step < counter[0];
+		counter[0] += step;
 	}
 
 	return 1;
@@ -392,8 +688,111 @@ uint8_t MERGE(uint8_t* stack, uint8_t* stack_length, const uint32_t* t, uint8_t
 	return 1;
 }
 
+uint8_t BLAKE3_push_chunks(const uint32_t* output, ptrdiff_t count, uint32_t* t,
+						   uint8_t* stack, uint8_t* stack_length, uint8_t d)
+{
+	for (ptrdiff_t index = 0; index < count; ++index)
+	{
+		if (!MERGE(stack, stack_length, t, d))
+		{
+			return 0;
+		}
+
+		if ((BLAKE3_STACK_LENGTH) == *stack_length)
+		{
+			return 0;
+		}
+
+#if __STDC_LIB_EXT1__
+		PUSH_CHUNK_TO_STACK_SEC(output + index * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t)), stack, *stack_length);
+#else
+		PUSH_CHUNK_TO_STACK(output + index * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t)), stack, *stack_length);
+#endif
+		t[0] += 1;
+	}
+
+	return 1;
+}
+
+struct BLAKE3_chunks_jobs
+{
+	uint8_t mutex[BUFFER_SIZE_OF];
+	const uint8_t* input;
+	uint32_t* output;
+	const uint32_t* t;
+	ptrdiff_t count;
+	ptrdiff_t next;
+	uint8_t d;
+	uint8_t result;
+};
+
+uint8_t BLAKE3_chunks_worker(void* argument)
+{
+	struct BLAKE3_chunks_jobs* jobs = (struct BLAKE3_chunks_jobs*)argument;
+
+	while (1)
+	{
+		thread_mutex_lock(jobs->mutex);
+		const ptrdiff_t first = BLAKE3_CHUNKS_PER_JOB * jobs->next++;
+		thread_mutex_unlock(jobs->mutex);
+
+		if (jobs->count <= first)
+		{
+			break;
+		}
+
+		uint32_t counter[2];
+		counter[0] = jobs->t[0] + (uint32_t)first;
+		counter[1] = jobs->t[1] + (counter[0] < jobs->t[0]);
+
+		if (!BLAKE3_hash_chunks(jobs->d, jobs->input + first * BLAKE3_CHUNK_LENGTH,
+								MIN(BLAKE3_CHUNKS_PER_JOB, jobs->count - first), counter,
+								jobs->output + first * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t))))
+		{
+			thread_mutex_lock(jobs->mutex);
+			jobs->result = 0;
+			thread_mutex_unlock(jobs->mutex);
+		}
+	}
+
+	return 1;
+}
+
+uint8_t BLAKE3_hash_chunks_in_threads(uint8_t d, const uint8_t* input, ptrdiff_t count, const uint32_t* t,
+									  uint16_t threads, uint32_t* output)
+{
+	/*NOTE: only chaining values of the chunks are calculated in threads, they are merged in the order of the input.*/
+	struct BLAKE3_chunks_jobs jobs;
+	/**/
+	jobs.input = input;
+	jobs.output = output;
+	jobs.t = t;
+	jobs.count = count;
+	jobs.next = 0;
+	jobs.d = d;
+	jobs.result = 1;
+
+	if (!buffer_init(jobs.mutex, BUFFER_SIZE_OF) ||
+		!thread_mutex_init(jobs.mutex))
+	{
+		thread_mutex_release(jobs.mutex);
+		return 0;
+	}
+
+#if defined(BLAKE3_X86)
+	/*NOTE: kernel is selected before the workers started, so they only read it.*/
+	BLAKE3_get_kernel();
+#endif
+	threads = (uint16_t)MIN(threads, (count + BLAKE3_CHUNKS_PER_JOB - 1) / BLAKE3_CHUNKS_PER_JOB);
+	const uint8_t returned = thread_run(threads, BLAKE3_chunks_worker, &jobs);
+	thread_mutex_release(jobs.mutex);
+	/**/
+	return returned && jobs.result;
+}
+
 uint8_t BLAKE3_core(const uint8_t* input, uint64_t length, uint32_t* m, uint8_t* l, uint32_t* h,
-					uint8_t* compressed, uint32_t* t, uint8_t* stack, uint8_t* stack_length, uint8_t d)
+					uint8_t* compressed, uint32_t* t, uint8_t* stack, uint8_t* stack_length, uint8_t d,
+					uint16_t threads)
 {
 	uint16_t to_process = (uint64_t)(BLAKE3_BLOCK_LENGTH) * (*compressed) + (*l);
 
@@ -415,46 +814,42 @@ uint8_t BLAKE3_core(const uint8_t* input, uint64_t length, uint32_t* m, uint8_t*
 		return 0 == length;
 	}
 
-	uint8_t number_of_chunks = 0;
-	const uint8_t* chunks[BLAKE3_MAXIMUM_CHUNKS_COUNT];
-	uint32_t output[(BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t)) * BLAKE3_MAXIMUM_CHUNKS_COUNT];
+	const ptrdiff_t count = (ptrdiff_t)(length / BLAKE3_CHUNK_LENGTH);
 
-	while (BLAKE3_CHUNK_LENGTH <= length)
+	if (1 < threads &&
+		2 * BLAKE3_CHUNKS_PER_JOB <= count)
 	{
-		while (BLAKE3_CHUNK_LENGTH <= length && number_of_chunks < BLAKE3_MAXIMUM_CHUNKS_COUNT)
-		{
-			chunks[number_of_chunks] = input;
-			input += BLAKE3_CHUNK_LENGTH;
-			length -= BLAKE3_CHUNK_LENGTH;
-			++number_of_chunks;
-		}
+		uint8_t output_buffer[BUFFER_SIZE_OF];
+		void* output = (void*)output_buffer;
 
-		if (!BLAKE3_hash_inputs(d, chunks, number_of_chunks, t, output))
+		if (!buffer_init(output, BUFFER_SIZE_OF) ||
+			!buffer_append(output, NULL, count * BLAKE3_OUTPUT_LENGTH) ||
+			!BLAKE3_hash_chunks_in_threads(d, input, count, t, threads, (uint32_t*)buffer_data(output, 0)) ||
+			!BLAKE3_push_chunks((const uint32_t*)buffer_data(output, 0), count, t, stack, stack_length, d))
 		{
+			buffer_release(output);
 			return 0;
 		}
 
-		for (uint64_t index = 0; index < number_of_chunks; ++index)
-		{
-			if (!MERGE(stack, stack_length, t, d))
-			{
-				return 0;
-			}
+		buffer_release(output);
+		input += count * BLAKE3_CHUNK_LENGTH;
+		length -= (uint64_t)count * BLAKE3_CHUNK_LENGTH;
+	}
 
-			if ((BLAKE3_STACK_LENGTH) == *stack_length)
-			{
-				return 0;
-			}
+	uint32_t output[(BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t)) * BLAKE3_MAXIMUM_CHUNKS_COUNT];
 
-#if __STDC_LIB_EXT1__
-			PUSH_CHUNK_TO_STACK_SEC(output + index * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t)), stack, *stack_length);
-#else
-			PUSH_CHUNK_TO_STACK(output + index * (BLAKE3_OUTPUT_LENGTH / sizeof(uint32_t)), stack, *stack_length);
-#endif
-			t[0] += 1;
+	while (BLAKE3_CHUNK_LENGTH <= length)
+	{
+		const uint8_t number_of_chunks = (uint8_t)MIN(length / BLAKE3_CHUNK_LENGTH, BLAKE3_MAXIMUM_CHUNKS_COUNT);
+
+		if (!BLAKE3_hash_chunks(d, input, number_of_chunks, t, output) ||
+			!BLAKE3_push_chunks(output, number_of_chunks, t, stack, stack_length, d))
+		{
+			return 0;
 		}
 
-		number_of_chunks = 0;
+		input += number_of_chunks * BLAKE3_CHUNK_LENGTH;
+		length -= number_of_chunks * BLAKE3_CHUNK_LENGTH;
 	}
 
 	if (0 < length)
@@ -648,7 +1043,7 @@ uint8_t BLAKE3(const uint8_t* start, const uint8_t* finish, uint8_t hash_length,
 	uint8_t stack[(uint16_t)BLAKE3_STACK_LENGTH * BLAKE3_OUTPUT_LENGTH];
 	uint8_t stack_length = 0;
 
-	if (0 < length && !BLAKE3_core(start, (uint64_t)length, m, &l, h, &compressed, t, stack, &stack_length, d))
+	if (0 < length && !BLAKE3_core(start, (uint64_t)length, m, &l, h, &compressed, t, stack, &stack_length, d, 1))
 	{
 		return 0;
 	}
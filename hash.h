@@ -35,9 +35,9 @@ uint8_t BLAKE2b_init(
 	uint8_t hash_length, uint64_t* output);
 uint8_t BLAKE2b_core(
 	const uint8_t* start, const uint8_t* finish,
-	ptrdiff_t* bytes_compressed, uint64_t* output);
+	uint64_t* bytes_compressed, uint64_t* output);
 uint8_t BLAKE2b_final(
-	const uint8_t* start, ptrdiff_t* bytes_compressed,
+	const uint8_t* start, uint64_t* bytes_compressed,
 	uint8_t bytes_remaining, uint64_t* output);
 
 uint8_t hash_algorithm_blake2b(
@@ -52,7 +52,8 @@ uint8_t BLAKE3_core(
 	const uint8_t* input, uint64_t length,
 	uint32_t* m, uint8_t* l, uint32_t* h,
 	uint8_t* compressed, uint32_t* t,
-	uint8_t* stack, uint8_t* stack_length, uint8_t d);
+	uint8_t* stack, uint8_t* stack_length, uint8_t d,
+	uint16_t threads);
 uint8_t BLAKE3_final(
 	const uint8_t* stack, uint8_t stack_length,
 	uint8_t compressed, uint32_t* t, uint32_t* h, uint32_t* m,
@@ -83,6 +84,13 @@ uint8_t hash_algorithm_sha3_final(
 	uint64_t* S, uint8_t rate_on_w, uint8_t d_max,
 	uint8_t* output);
 
+uint8_t hash_algorithm_shake_init(
+	uint16_t security_strength, uint8_t* rate_on_w, uint8_t* maximum_delta);
+uint8_t hash_algorithm_shake_final(
+	uint8_t* queue, uint8_t queue_size, uint8_t maximum_delta,
+	uint64_t* S, uint8_t rate_on_w, uint16_t d_max,
+	uint8_t* output);
+
 uint8_t hash_algorithm_keccak(
 	const uint8_t* start, const uint8_t* finish,
 	uint16_t hash_length, void* output);
@@ -91,6 +99,10 @@ uint8_t hash_algorithm_sha3(
 	const uint8_t* start, const uint8_t* finish,
 	uint16_t hash_length, void* output);
 
+uint8_t hash_algorithm_shake(
+	const uint8_t* start, const uint8_t* finish,
+	uint16_t security_strength, uint16_t hash_length, void* output);
+
 uint8_t hash_algorithm_XXH32_core(
 	const uint8_t* start, const uint8_t* finish,
 	uint8_t* queue, uint8_t* queue_size, uint8_t max_queue_size,
@@ -120,4 +132,23 @@ uint8_t hash_algorithm_XXH64(
 	const uint8_t* start, const uint8_t* finish,
 	uint64_t seed, uint64_t* output);
 
+uint8_t hash_algorithm_XXH3_init(
+	uint64_t seed, uint64_t* accumulators, uint8_t* secret);
+uint8_t hash_algorithm_XXH3_core(
+	const uint8_t* start, const uint8_t* finish,
+	uint8_t* queue, uint16_t* queue_size,
+	uint64_t* accumulators, const uint8_t* secret);
+uint8_t hash_algorithm_XXH3_64_final(
+	const uint8_t* queue, uint16_t queue_size,
+	const uint64_t* accumulators, const uint8_t* secret,
+	uint64_t seed, uint64_t* output);
+uint8_t hash_algorithm_XXH3_128_final(
+	const uint8_t* queue, uint16_t queue_size,
+	const uint64_t* accumulators, const uint8_t* secret,
+	uint64_t seed, uint64_t* output);
+
+uint8_t hash_algorithm_XXH3(
+	const uint8_t* start, const uint8_t* finish,
+	uint64_t seed, uint8_t is_128, uint64_t* output);
+
 #endif
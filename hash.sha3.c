@@ -21,6 +21,10 @@
  * SHA-3 Standard: Permutation-Based Hash and Extendable-Output Functions.
  * Date Published: August 2015.
  * https://csrc.nist.gov/publications/detail/fips/202/final
+ *
+ * The Keccak team. Keccak implementation overview. Version 3.2.
+ * Date: May 29, 2012.
+ * https://keccak.team/files/Keccak-implementation-3.2.pdf
  */
 
 #include "stdc_secure_api.h"
@@ -29,215 +33,323 @@
 #include "buffer.h"
 #include "common.h"
 
-#if defined(__clang__) && defined(NDEBUG)
-#include "echo.h"
-#endif
-
 #include <stddef.h>
 #include <string.h>
 
-static const uint8_t w = 64;
-
-#define TWO_DIMENSION_TO_ONE_INDEX(X, Y, Y_MAX)	\
-	(X) * (Y_MAX) + (Y)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define KECCAK_X86
+#define KECCAK_TARGET(NAME) __attribute__((target(NAME)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define KECCAK_X86
+#define KECCAK_TARGET(NAME)
+#include <intrin.h>
+#endif
 
-#define ROT(X, N, W)	\
-	(((X) << ((N) % (W))) | ((X) >> ((W) - ((N) % (W)))))
+static const uint8_t w = 64;
 
-void theta(uint64_t* A, uint64_t* C, uint64_t* D)
+/*l -> log(w) / log(2)
+number of permutation -> 12 + 2 * l
+static const uint8_t n = 12, 14, 16, 18, 20, 22, 24*/
+static const uint64_t RC[] =
 {
-	for (uint8_t i = 0; i < 5; ++i)
+	0x0000000000000001,
+	0x0000000000008082,
+	0x800000000000808A,
+	0x8000000080008000,
+	0x000000000000808B,
+	0x0000000080000001,
+	0x8000000080008081,
+	0x8000000000008009,
+	0x000000000000008A,
+	0x0000000000000088,
+	0x0000000080008009,
+	0x000000008000000A,
+	0x000000008000808B,
+	0x800000000000008B,
+	0x8000000000008089,
+	0x8000000000008003,
+	0x8000000000008002,
+	0x8000000000000080,
+	0x000000000000800A,
+	0x800000008000000A,
+	0x8000000080008081,
+	0x8000000000008080,
+	0x0000000080000001,
+	0x8000000080008008
+};
+
+#define KECCAK_READ_UINT64_T(INPUT)										\
+	((uint64_t)(INPUT)[0] | (uint64_t)(INPUT)[1] << 8 |					\
+	 (uint64_t)(INPUT)[2] << 16 | (uint64_t)(INPUT)[3] << 24 |			\
+	 (uint64_t)(INPUT)[4] << 32 | (uint64_t)(INPUT)[5] << 40 |			\
+	 (uint64_t)(INPUT)[6] << 48 | (uint64_t)(INPUT)[7] << 56)
+
+#define ROTATE_LEFT_UINT64_T(VALUE, OFFSET)		\
+	(((VALUE) << (OFFSET)) | (VALUE) >> (64 - (OFFSET)))
+
+/*NOTE: state lanes are stored at S[x + 5 * y], as FIPS 202 define.
+  Lanes are named by the row (b, g, k, m, s) and the column (a, e, i, o, u);
+  round macro join theta, rho, pi, chi and iota steps.
+  Lanes be, bi, go, ki, mi and sa are kept complemented while rounds are run,
+  so chi step need only one NOT per row.*/
+#define KECCAK_ROUND(A, E, RC_I)								\
+	C[0] = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;				\
+	C[1] = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;				\
+	C[2] = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;				\
+	C[3] = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;				\
+	C[4] = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;				\
+	D[0] = C[4] ^ ROTATE_LEFT_UINT64_T(C[1], 1);				\
+	D[1] = C[0] ^ ROTATE_LEFT_UINT64_T(C[2], 1);				\
+	D[2] = C[1] ^ ROTATE_LEFT_UINT64_T(C[3], 1);				\
+	D[3] = C[2] ^ ROTATE_LEFT_UINT64_T(C[4], 1);				\
+	D[4] = C[3] ^ ROTATE_LEFT_UINT64_T(C[0], 1);				\
+	B[0] = A##ba ^ D[0];										\
+	B[1] = ROTATE_LEFT_UINT64_T(A##ge ^ D[1], 44);				\
+	B[2] = ROTATE_LEFT_UINT64_T(A##ki ^ D[2], 43);				\
+	B[3] = ROTATE_LEFT_UINT64_T(A##mo ^ D[3], 21);				\
+	B[4] = ROTATE_LEFT_UINT64_T(A##su ^ D[4], 14);				\
+	E##ba = B[0] ^ (B[1] | B[2]) ^ (RC_I);						\
+	E##be = B[1] ^ (~B[2] | B[3]);								\
+	E##bi = B[2] ^ (B[3] & B[4]);								\
+	E##bo = B[3] ^ (B[4] | B[0]);								\
+	E##bu = B[4] ^ (B[0] & B[1]);								\
+	B[0] = ROTATE_LEFT_UINT64_T(A##bo ^ D[3], 28);				\
+	B[1] = ROTATE_LEFT_UINT64_T(A##gu ^ D[4], 20);				\
+	B[2] = ROTATE_LEFT_UINT64_T(A##ka ^ D[0], 3);				\
+	B[3] = ROTATE_LEFT_UINT64_T(A##me ^ D[1], 45);				\
+	B[4] = ROTATE_LEFT_UINT64_T(A##si ^ D[2], 61);				\
+	E##ga = B[0] ^ (B[1] | B[2]);								\
+	E##ge = B[1] ^ (B[2] & B[3]);								\
+	E##gi = B[2] ^ (B[3] | ~B[4]);								\
+	E##go = B[3] ^ (B[4] | B[0]);								\
+	E##gu = B[4] ^ (B[0] & B[1]);								\
+	B[0] = ROTATE_LEFT_UINT64_T(A##be ^ D[1], 1);				\
+	B[1] = ROTATE_LEFT_UINT64_T(A##gi ^ D[2], 6);				\
+	B[2] = ROTATE_LEFT_UINT64_T(A##ko ^ D[3], 25);				\
+	B[3] = ROTATE_LEFT_UINT64_T(A##mu ^ D[4], 8);				\
+	B[4] = ROTATE_LEFT_UINT64_T(A##sa ^ D[0], 18);				\
+	E##ka = B[0] ^ (B[1] | B[2]);								\
+	E##ke = B[1] ^ (B[2] & B[3]);								\
+	E##ki = B[2] ^ (~B[3] & B[4]);								\
+	E##ko = ~B[3] ^ (B[4] | B[0]);								\
+	E##ku = B[4] ^ (B[0] & B[1]);								\
+	B[0] = ROTATE_LEFT_UINT64_T(A##bu ^ D[4], 27);				\
+	B[1] = ROTATE_LEFT_UINT64_T(A##ga ^ D[0], 36);				\
+	B[2] = ROTATE_LEFT_UINT64_T(A##ke ^ D[1], 10);				\
+	B[3] = ROTATE_LEFT_UINT64_T(A##mi ^ D[2], 15);				\
+	B[4] = ROTATE_LEFT_UINT64_T(A##so ^ D[3], 56);				\
+	E##ma = B[0] ^ (B[1] & B[2]);								\
+	E##me = B[1] ^ (B[2] | B[3]);								\
+	E##mi = B[2] ^ (~B[3] | B[4]);								\
+	E##mo = ~B[3] ^ (B[4] & B[0]);								\
+	E##mu = B[4] ^ (B[0] | B[1]);								\
+	B[0] = ROTATE_LEFT_UINT64_T(A##bi ^ D[2], 62);				\
+	B[1] = ROTATE_LEFT_UINT64_T(A##go ^ D[3], 55);				\
+	B[2] = ROTATE_LEFT_UINT64_T(A##ku ^ D[4], 39);				\
+	B[3] = ROTATE_LEFT_UINT64_T(A##ma ^ D[0], 41);				\
+	B[4] = ROTATE_LEFT_UINT64_T(A##se ^ D[1], 2);				\
+	E##sa = B[0] ^ (~B[1] & B[2]);								\
+	E##se = ~B[1] ^ (B[2] | B[3]);								\
+	E##si = B[2] ^ (B[3] & B[4]);								\
+	E##so = B[3] ^ (B[4] | B[0]);								\
+	E##su = B[4] ^ (B[0] & B[1]);
+
+#if defined(KECCAK_X86)
+/*NOTE: row y of pi output take lane x from row x, column x + 3 * y, of rho output.
+  So lanes are first collected by blend into the diagonal, where lane k come from row k + 2 * y,
+  and then diagonal is rotated for chi step.*/
+#define KECCAK_AVX512_ROW(A_Y, T, B_0, B_1, B_2, B_3, B_4)					\
+	diagonal = _mm512_mask_blend_epi64(0x02, (B_0), (B_1));					\
+	diagonal = _mm512_mask_blend_epi64(0x04, diagonal, (B_2));				\
+	diagonal = _mm512_mask_blend_epi64(0x08, diagonal, (B_3));				\
+	diagonal = _mm512_mask_blend_epi64(0x10, diagonal, (B_4));				\
+	(A_Y) = _mm512_ternarylogic_epi64(										\
+				_mm512_permutexvar_epi64(rotation[(T)], diagonal),			\
+				_mm512_permutexvar_epi64(rotation[((T) + 1) % 5], diagonal),	\
+				_mm512_permutexvar_epi64(rotation[((T) + 2) % 5], diagonal), 0xD2);
+
+KECCAK_TARGET("avx512f")
+void Keccak_f_avx512(uint64_t* S)
+{
+	/*NOTE: each register hold one row of the state at the lanes 0 - 4.*/
+	const __m512i rotation[] =
 	{
-		C[i] = A[TWO_DIMENSION_TO_ONE_INDEX(i, 0, 5)] ^
-			   A[TWO_DIMENSION_TO_ONE_INDEX(i, 1, 5)] ^
-			   A[TWO_DIMENSION_TO_ONE_INDEX(i, 2, 5)] ^
-			   A[TWO_DIMENSION_TO_ONE_INDEX(i, 3, 5)] ^
-			   A[TWO_DIMENSION_TO_ONE_INDEX(i, 4, 5)];
-	}
+		_mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7),
+		_mm512_setr_epi64(1, 2, 3, 4, 0, 5, 6, 7),
+		_mm512_setr_epi64(2, 3, 4, 0, 1, 5, 6, 7),
+		_mm512_setr_epi64(3, 4, 0, 1, 2, 5, 6, 7),
+		_mm512_setr_epi64(4, 0, 1, 2, 3, 5, 6, 7)
+	};
+	const __m512i rho_0 = _mm512_setr_epi64(0, 1, 62, 28, 27, 0, 0, 0);
+	const __m512i rho_1 = _mm512_setr_epi64(36, 44, 6, 55, 20, 0, 0, 0);
+	const __m512i rho_2 = _mm512_setr_epi64(3, 10, 43, 25, 39, 0, 0, 0);
+	const __m512i rho_3 = _mm512_setr_epi64(41, 45, 15, 21, 8, 0, 0, 0);
+	const __m512i rho_4 = _mm512_setr_epi64(18, 2, 61, 56, 14, 0, 0, 0);
+	/**/
+	__m512i A_0 = _mm512_maskz_loadu_epi64(0x1F, S);
+	__m512i A_1 = _mm512_maskz_loadu_epi64(0x1F, S + 5);
+	__m512i A_2 = _mm512_maskz_loadu_epi64(0x1F, S + 10);
+	__m512i A_3 = _mm512_maskz_loadu_epi64(0x1F, S + 15);
+	__m512i A_4 = _mm512_maskz_loadu_epi64(0x1F, S + 20);
 
-	for (uint8_t i = 0; i < 5; ++i)
+	for (uint8_t i = 0; i < 24; ++i)
 	{
-		D[i] = C[(i + 4) % 5] ^ ROT(C[(i + 1) % 5], 1, w);
+		__m512i C = _mm512_ternarylogic_epi64(A_0, A_1, A_2, 0x96);
+		C = _mm512_ternarylogic_epi64(C, A_3, A_4, 0x96);
+		const __m512i D = _mm512_xor_si512(
+							  _mm512_permutexvar_epi64(rotation[4], C),
+							  _mm512_rol_epi64(_mm512_permutexvar_epi64(rotation[1], C), 1));
+		/**/
+		const __m512i B_0 = _mm512_rolv_epi64(_mm512_xor_si512(A_0, D), rho_0);
+		const __m512i B_1 = _mm512_rolv_epi64(_mm512_xor_si512(A_1, D), rho_1);
+		const __m512i B_2 = _mm512_rolv_epi64(_mm512_xor_si512(A_2, D), rho_2);
+		const __m512i B_3 = _mm512_rolv_epi64(_mm512_xor_si512(A_3, D), rho_3);
+		const __m512i B_4 = _mm512_rolv_epi64(_mm512_xor_si512(A_4, D), rho_4);
+		/**/
+		__m512i diagonal;
+		KECCAK_AVX512_ROW(A_0, 0, B_0, B_1, B_2, B_3, B_4)
+		KECCAK_AVX512_ROW(A_1, 3, B_2, B_3, B_4, B_0, B_1)
+		KECCAK_AVX512_ROW(A_2, 1, B_4, B_0, B_1, B_2, B_3)
+		KECCAK_AVX512_ROW(A_3, 4, B_1, B_2, B_3, B_4, B_0)
+		KECCAK_AVX512_ROW(A_4, 2, B_3, B_4, B_0, B_1, B_2)
+		/**/
+		A_0 = _mm512_xor_si512(A_0, _mm512_maskz_set1_epi64(1, (long long)RC[i]));
 	}
 
-	for (uint8_t i = 0; i < 5; ++i)
-	{
-		for (uint8_t j = 0; j < 5; ++j)
-		{
-			A[TWO_DIMENSION_TO_ONE_INDEX(i, j, 5)] ^= D[i];
-		}
-	}
+	_mm512_mask_storeu_epi64(S, 0x1F, A_0);
+	_mm512_mask_storeu_epi64(S + 5, 0x1F, A_1);
+	_mm512_mask_storeu_epi64(S + 10, 0x1F, A_2);
+	_mm512_mask_storeu_epi64(S + 15, 0x1F, A_3);
+	_mm512_mask_storeu_epi64(S + 20, 0x1F, A_4);
 }
 
-void rho_pi(const uint64_t* A, uint64_t* B)
-{
-	static const uint8_t r[] =
-	{
-		0, 36, 3, 41, 18,
-		1, 44, 10, 45, 2,
-		62, 6, 43, 15, 61,
-		28, 55, 25, 21, 56,
-		27, 20, 39, 8, 14
-	};
+static uint8_t is_keccak_avx512_supported = UINT8_MAX;
 
-	for (uint8_t i = 0; i < 5; ++i)
+uint8_t Keccak_is_avx512_supported()
+{
+	if (UINT8_MAX != is_keccak_avx512_supported)
 	{
-		for (uint8_t j = 0; j < 5; ++j)
-		{
-#if defined(__clang__) && defined(NDEBUG)
-			const uint8_t index_1 = TWO_DIMENSION_TO_ONE_INDEX(j, (2 * i + 3 * j) % 5, 5);
-			const uint8_t index_2 = TWO_DIMENSION_TO_ONE_INDEX(i, j, 5);
-			B[index_1] = ROT(A[index_2], r[index_2], w);
-			echo(0, 0, NULL, None, (const uint8_t*)&B[index_1], sizeof(uint64_t), 0, 0);
-#else
-			B[TWO_DIMENSION_TO_ONE_INDEX(j, (2 * i + 3 * j) % 5, 5)] =
-				ROT(A[TWO_DIMENSION_TO_ONE_INDEX(i, j, 5)],
-					r[TWO_DIMENSION_TO_ONE_INDEX(i, j, 5)], w);
-#endif
-		}
+		return is_keccak_avx512_supported;
 	}
-}
 
-void chi(uint64_t* A, const uint64_t* B)
-{
-	for (uint8_t i = 0; i < 5; ++i)
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int count = info[0];
+	__cpuid(info, 1);
+	/*NOTE: ZMM registers also should be saved by the operating system.*/
+	const uint8_t os_support = 0 != (info[2] & (1 << 27)) && 0xE6 == (_xgetbv(0) & 0xE6);
+	is_keccak_avx512_supported = 0;
+
+	if (7 <= count)
 	{
-		for (uint8_t j = 0; j < 5; ++j)
-		{
-			A[TWO_DIMENSION_TO_ONE_INDEX(i, j, 5)] =
-				B[TWO_DIMENSION_TO_ONE_INDEX(i, j, 5)] ^
-				((~B[TWO_DIMENSION_TO_ONE_INDEX((i + 1) % 5, j, 5)]) &
-				 B[TWO_DIMENSION_TO_ONE_INDEX((i + 2) % 5, j, 5)]);
-		}
+		__cpuidex(info, 7, 0);
+		is_keccak_avx512_supported = os_support && 0 != (info[1] & (1 << 16));
 	}
-}
 
-void iota(uint64_t* A, uint64_t RC_i)
-{
-	A[TWO_DIMENSION_TO_ONE_INDEX(0, 0, 5)] ^= RC_i;
+#else
+	__builtin_cpu_init();
+	is_keccak_avx512_supported = 0 != __builtin_cpu_supports("avx512f");
+#endif
+	return is_keccak_avx512_supported;
 }
-
-void Keccak_f(uint64_t* A)
+#endif
+void Keccak_f(uint64_t* S)
 {
-	/*l -> log(w) / log(2)
-	number of permutation -> 12 + 2 * l
-	static const uint8_t n = 12, 14, 16, 18, 20, 22, 24*/
-	static const uint64_t RC[] =
-	{
-		0x0000000000000001,
-		0x0000000000008082,
-		0x800000000000808A,
-		0x8000000080008000,
-		0x000000000000808B,
-		0x0000000080000001,
-		0x8000000080008081,
-		0x8000000000008009,
-		0x000000000000008A,
-		0x0000000000000088,
-		0x0000000080008009,
-		0x000000008000000A,
-		0x000000008000808B,
-		0x800000000000008B,
-		0x8000000000008089,
-		0x8000000000008003,
-		0x8000000000008002,
-		0x8000000000000080,
-		0x000000000000800A,
-		0x800000008000000A,
-		0x8000000080008081,
-		0x8000000000008080,
-		0x0000000080000001,
-		0x8000000080008008
-	};
-	/**/
-	uint64_t B[25];
-	uint64_t* C = B;
-	uint64_t* D = B + 5;
+#if defined(KECCAK_X86)
 
-	for (uint8_t i = 0; i < 24; ++i)
+	if (Keccak_is_avx512_supported())
 	{
-		theta(A, C, D);
-		rho_pi(A, B);
-		chi(A, B);
-		iota(A, RC[i]);
+		Keccak_f_avx512(S);
+		return;
 	}
-}
 
-void Keccak_absorption(const uint64_t* data, uint64_t* S, uint8_t rate_on_w)
-{
-	/*Absorption phase*/
-	for (uint8_t i = 0; i < 5; ++i)
-	{
-		for (uint8_t j = 0; j < 5; ++j)
-		{
-			const uint8_t source_index = TWO_DIMENSION_TO_ONE_INDEX(j, i, 5);
+#endif
+	/*TODO: AVX2 kernel - one row do not fit to the YMM register, so it should be interleaved with other state.*/
+	uint64_t Aba = S[0], Abe = ~S[1], Abi = ~S[2], Abo = S[3], Abu = S[4];
+	uint64_t Aga = S[5], Age = S[6], Agi = S[7], Ago = ~S[8], Agu = S[9];
+	uint64_t Aka = S[10], Ake = S[11], Aki = ~S[12], Ako = S[13], Aku = S[14];
+	uint64_t Ama = S[15], Ame = S[16], Ami = ~S[17], Amo = S[18], Amu = S[19];
+	uint64_t Asa = ~S[20], Ase = S[21], Asi = S[22], Aso = S[23], Asu = S[24];
+	/**/
+	uint64_t Eba, Ebe, Ebi, Ebo, Ebu;
+	uint64_t Ega, Ege, Egi, Ego, Egu;
+	uint64_t Eka, Eke, Eki, Eko, Eku;
+	uint64_t Ema, Eme, Emi, Emo, Emu;
+	uint64_t Esa, Ese, Esi, Eso, Esu;
+	/**/
+	uint64_t B[5];
+	uint64_t C[5];
+	uint64_t D[5];
 
-			if (source_index < rate_on_w)
-			{
-				const uint8_t destination_index = TWO_DIMENSION_TO_ONE_INDEX(i, j, 5);
-				S[destination_index] ^= data[source_index];
-			}
-		}
+	for (uint8_t i = 0; i < 24; i += 2)
+	{
+		KECCAK_ROUND(A, E, RC[i])
+		KECCAK_ROUND(E, A, RC[i + 1])
 	}
 
-	Keccak_f(S);
+	S[0] = Aba;
+	S[1] = ~Abe;
+	S[2] = ~Abi;
+	S[3] = Abo;
+	S[4] = Abu;
+	S[5] = Aga;
+	S[6] = Age;
+	S[7] = Agi;
+	S[8] = ~Ago;
+	S[9] = Agu;
+	S[10] = Aka;
+	S[11] = Ake;
+	S[12] = ~Aki;
+	S[13] = Ako;
+	S[14] = Aku;
+	S[15] = Ama;
+	S[16] = Ame;
+	S[17] = ~Ami;
+	S[18] = Amo;
+	S[19] = Amu;
+	S[20] = ~Asa;
+	S[21] = Ase;
+	S[22] = Asi;
+	S[23] = Aso;
+	S[24] = Asu;
 }
 
 uint8_t Keccak_absorption_bytes(const uint8_t* data, uint64_t* S, uint8_t rate_on_w)
 {
 	if (!data ||
 		!S ||
-		18 < rate_on_w)
+		25 <= rate_on_w)
 	{
 		return 0;
 	}
 
-	uint64_t data_[18];
-
-	for (uint8_t i = 0; i < rate_on_w; ++i)
+	/*Absorption phase*/
+	for (uint8_t i = 0; i < rate_on_w; ++i, data += sizeof(uint64_t))
 	{
-		const uint8_t* start = data + 8 * i;
-		const uint8_t* finish = start + 8;
-
-		if (!hash_algorithm_uint8_t_array_to_uint64_t(start, finish, &data_[i]))
-		{
-			return 0;
-		}
+		S[i] ^= KECCAK_READ_UINT64_T(data);
 	}
 
-	Keccak_absorption(data_, S, rate_on_w);
+	Keccak_f(S);
 	return 1;
 }
 
-uint8_t Keccak_squeezing(uint64_t* S, uint8_t rate_on_w, uint8_t d_max, uint8_t* output)
+uint8_t Keccak_squeezing(uint64_t* S, uint8_t rate_on_w, uint16_t d_max, uint8_t* output)
 {
 	/*Squeezing phase*/
-	for (uint8_t xF = 0; xF < d_max;)
+	for (uint16_t xF = 0; xF < d_max;)
 	{
-		for (uint8_t i = 0; i < 5; ++i)
+		for (uint8_t i = 0; i < rate_on_w; ++i)
 		{
-			for (uint8_t j = 0; j < 5; ++j)
+			for (uint8_t j = 0; j < sizeof(uint64_t) && xF < d_max; ++j, ++xF)
 			{
-				if (TWO_DIMENSION_TO_ONE_INDEX(i, j, 5) < rate_on_w)
-				{
-					const uint64_t* s = &(S[TWO_DIMENSION_TO_ONE_INDEX(j, i, 5)]);
-#if __STDC_LIB_EXT1__
-
-					if (0 != memcpy_s(output + xF, sizeof(uint64_t), s, sizeof(uint64_t)))
-					{
-						return 0;
-					}
-
-#else
-					memcpy(output + xF, s, sizeof(uint64_t));
-#endif
-					xF += sizeof(uint64_t);
+				output[xF] = (uint8_t)(S[i] >> (8 * j));
+			}
 
-					if (d_max <= xF)
-					{
-						return 1;
-					}
-				}
+			if (d_max <= xF)
+			{
+				return 1;
 			}
 		}
 
@@ -247,6 +359,23 @@ uint8_t Keccak_squeezing(uint64_t* S, uint8_t rate_on_w, uint8_t d_max, uint8_t*
 	return 0;
 }
 
+uint8_t Keccak_padding(uint8_t suffix,
+					   uint8_t* queue, uint8_t queue_size, uint8_t maximum_delta,
+					   uint64_t* S, uint8_t rate_on_w)
+{
+	if (!queue ||
+		maximum_delta <= queue_size)
+	{
+		return 0;
+	}
+
+	memset(queue + queue_size, 0, maximum_delta - queue_size);
+	queue[queue_size] = suffix;
+	queue[maximum_delta - 1] |= 128;
+	/**/
+	return Keccak_absorption_bytes(queue, S, rate_on_w);
+}
+
 uint8_t hash_algorithm_sha3_init(
 	uint16_t hash_length,
 	uint8_t* rate_on_w,
@@ -289,6 +418,29 @@ uint8_t hash_algorithm_sha3_init(
 	return 1;
 }
 
+uint8_t hash_algorithm_shake_init(
+	uint16_t security_strength,
+	uint8_t* rate_on_w,
+	uint8_t* maximum_delta)
+{
+	static const uint16_t permutation_width = 1600;
+
+	if ((128 != security_strength &&
+		 256 != security_strength) ||
+		NULL == rate_on_w ||
+		NULL == maximum_delta)
+	{
+		return 0;
+	}
+
+	const uint16_t rate = permutation_width - 2 * security_strength;
+	/**/
+	*rate_on_w = (uint8_t)(rate / w);
+	*maximum_delta = (*rate_on_w) * 8;
+	/**/
+	return 1;
+}
+
 uint8_t hash_algorithm_sha3_core(
 	const uint8_t* start, const uint8_t* finish,
 	uint8_t* queue, uint8_t* queue_size, uint8_t maximum_delta,
@@ -364,25 +516,17 @@ uint8_t hash_algorithm_sha3_final(
 	uint64_t* S, uint8_t rate_on_w, uint8_t d_max,
 	uint8_t* output)
 {
-	const uint8_t delta = maximum_delta - queue_size;
-	memset(queue + queue_size, 0, delta);
-	queue[queue_size] = is_sha3 ? 6 : 1;
-
-	if (1 == delta)
-	{
-		queue[maximum_delta - 1] = (is_sha3 ? 6 : 1) + 128;
-	}
-	else
-	{
-		queue[maximum_delta - 1] = 128;
-	}
-
-	if (!Keccak_absorption_bytes(queue, S, rate_on_w))
-	{
-		return 0;
-	}
+	return Keccak_padding(is_sha3 ? 6 : 1, queue, queue_size, maximum_delta, S, rate_on_w) &&
+		   Keccak_squeezing(S, rate_on_w, d_max, output);
+}
 
-	return Keccak_squeezing(S, rate_on_w, d_max, output);
+uint8_t hash_algorithm_shake_final(
+	uint8_t* queue, uint8_t queue_size, uint8_t maximum_delta,
+	uint64_t* S, uint8_t rate_on_w, uint16_t d_max,
+	uint8_t* output)
+{
+	return Keccak_padding(0x1F, queue, queue_size, maximum_delta, S, rate_on_w) &&
+		   Keccak_squeezing(S, rate_on_w, d_max, output);
 }
 
 uint8_t Keccak(const uint8_t* input, ptrdiff_t length, uint8_t is_sha3,
@@ -443,3 +587,53 @@ uint8_t hash_algorithm_sha3(const uint8_t* start, const uint8_t* finish, uint16_
 				  (buffer_uint8_t_data(output, 0) + buffer_size(output) - UINT8_MAX)) &&
 		   buffer_resize(output, buffer_size(output) - ((ptrdiff_t)UINT8_MAX - hash_length / 8));
 }
+
+uint8_t hash_algorithm_shake(const uint8_t* start, const uint8_t* finish, uint16_t security_strength,
+							 uint16_t hash_length, void* output)
+{
+	if (NULL == start ||
+		NULL == finish ||
+		finish < start ||
+		0 == hash_length ||
+		0 != hash_length % 8 ||
+		NULL == output)
+	{
+		return 0;
+	}
+
+	uint8_t rate_on_w;
+	uint8_t maximum_delta;
+
+	if (!hash_algorithm_shake_init(security_strength, &rate_on_w, &maximum_delta))
+	{
+		return 0;
+	}
+
+	uint8_t queue[192];
+	uint8_t queue_size = 0;
+	uint64_t S[] =
+	{
+		0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0
+	};
+
+	if (!hash_algorithm_sha3_core(start, finish, queue, &queue_size, maximum_delta, S, rate_on_w))
+	{
+		return 0;
+	}
+
+	const ptrdiff_t size = buffer_size(output);
+	hash_length = hash_length / 8;
+
+	if (!buffer_append(output, NULL, hash_length))
+	{
+		return 0;
+	}
+
+	return hash_algorithm_shake_final(
+			   queue, queue_size, maximum_delta, S, rate_on_w,
+			   hash_length, buffer_uint8_t_data(output, size));
+}
@@ -9,6 +9,8 @@
  * As reference used:
  * xxHash fast digest algorithm. Version 0.1.1 (10/10/18)
  * https://github.com/Cyan4973/xxHash/blob/ff5df558b7bad19bc060d756f4dbd528b202c820/doc/xxhash_spec.md
+ * XXH3 - xxHash library, version 0.8.2
+ * https://github.com/Cyan4973/xxHash/blob/v0.8.2/xxhash.h
  */
 
 #include "stdc_secure_api.h"
@@ -505,3 +507,726 @@ uint8_t hash_algorithm_XXH64(
 			   queue, queue + queue_size,
 			   accumulators, is_accumulators_initialized, seed, output);
 }
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define XXH3_X86
+#define XXH3_TARGET(NAME) __attribute__((target(NAME)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define XXH3_X86
+#define XXH3_TARGET(NAME)
+#include <intrin.h>
+#endif
+
+#define XXH3_STRIPE_LENGTH			64
+#define XXH3_SECRET_LENGTH			192
+#define XXH3_SECRET_CONSUME_RATE	8
+#define XXH3_STRIPES_PER_BLOCK		((XXH3_SECRET_LENGTH - XXH3_STRIPE_LENGTH) / XXH3_SECRET_CONSUME_RATE)
+#define XXH3_SECRET_LIMIT			(XXH3_SECRET_LENGTH - XXH3_STRIPE_LENGTH)
+#define XXH3_SECRET_LAST_STRIPE		7
+#define XXH3_SECRET_MERGE			11
+#define XXH3_QUEUE_LENGTH			256
+#define XXH3_MID_SIZE_MAX			240
+#define XXH3_MID_SIZE_START			3
+#define XXH3_MID_SIZE_LAST			17
+/*NOTE: lanes, stripes consumed at the current block and total length.*/
+#define XXH3_ACCUMULATORS_COUNT		10
+
+static const uint8_t XXH3_SECRET[XXH3_SECRET_LENGTH] =
+{
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+static const uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+static const uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+#define XXH3_READ_UINT32_T(INPUT)																\
+	((uint32_t)(INPUT)[0] | (uint32_t)(INPUT)[1] << 8 |											\
+	 (uint32_t)(INPUT)[2] << 16 | (uint32_t)(INPUT)[3] << 24)
+
+#define XXH3_READ_UINT64_T(INPUT)																\
+	((uint64_t)XXH3_READ_UINT32_T(INPUT) | (uint64_t)XXH3_READ_UINT32_T((INPUT) + 4) << 32)
+
+#define XXH3_SWAP_UINT32_T(VALUE)																\
+	(((VALUE) << 24) | (((VALUE) << 8) & 0xFF0000) | (((VALUE) >> 8) & 0xFF00) | ((VALUE) >> 24))
+
+#define XXH3_SWAP_UINT64_T(VALUE)																\
+	((uint64_t)XXH3_SWAP_UINT32_T((uint32_t)(VALUE)) << 32 |									\
+	 (uint64_t)XXH3_SWAP_UINT32_T((uint32_t)((VALUE) >> 32)))
+
+uint64_t XXH3_multiply(uint64_t lhs, uint64_t rhs, uint64_t* high)
+{
+#if defined(__SIZEOF_INT128__)
+	const unsigned __int128 product = (unsigned __int128)lhs * rhs;
+	*high = (uint64_t)(product >> 64);
+	return (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(lhs, rhs, high);
+#else
+	const uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+	const uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+	const uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+	const uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+	const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+	*high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+	return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+uint64_t XXH3_multiply_fold(uint64_t lhs, uint64_t rhs)
+{
+	uint64_t high;
+	const uint64_t low = XXH3_multiply(lhs, rhs, &high);
+	return low ^ high;
+}
+
+uint64_t XXH64_avalanche(uint64_t input)
+{
+	input ^= input >> 33;
+	input *= PRIME64_2;
+	input ^= input >> 29;
+	input *= PRIME64_3;
+	return input ^ (input >> 32);
+}
+
+uint64_t XXH3_avalanche(uint64_t input)
+{
+	input ^= input >> 37;
+	input *= PRIME_MX1;
+	return input ^ (input >> 32);
+}
+
+uint64_t XXH3_rrmxmx(uint64_t input, uint64_t length)
+{
+	input ^= ROTATE_LEFT_UINT64_T(input, 49) ^ ROTATE_LEFT_UINT64_T(input, 24);
+	input *= PRIME_MX2;
+	input ^= (input >> 35) + length;
+	input *= PRIME_MX2;
+	return input ^ (input >> 28);
+}
+
+uint64_t XXH3_mix_16(const uint8_t* input, const uint8_t* secret, uint64_t seed)
+{
+	return XXH3_multiply_fold(
+			   XXH3_READ_UINT64_T(input) ^ (XXH3_READ_UINT64_T(secret) + seed),
+			   XXH3_READ_UINT64_T(input + 8) ^ (XXH3_READ_UINT64_T(secret + 8) - seed));
+}
+
+void XXH3_mix_32(uint64_t* output, const uint8_t* input_1, const uint8_t* input_2,
+				 const uint8_t* secret, uint64_t seed)
+{
+	output[0] += XXH3_mix_16(input_1, secret, seed);
+	output[0] ^= XXH3_READ_UINT64_T(input_2) + XXH3_READ_UINT64_T(input_2 + 8);
+	output[1] += XXH3_mix_16(input_2, secret + 16, seed);
+	output[1] ^= XXH3_READ_UINT64_T(input_1) + XXH3_READ_UINT64_T(input_1 + 8);
+}
+
+uint64_t XXH3_64_short(const uint8_t* input, uint64_t length, const uint8_t* secret, uint64_t seed)
+{
+	if (length <= 16)
+	{
+		if (8 < length)
+		{
+			const uint64_t low = XXH3_READ_UINT64_T(input) ^
+								 ((XXH3_READ_UINT64_T(secret + 24) ^ XXH3_READ_UINT64_T(secret + 32)) + seed);
+			const uint64_t high = XXH3_READ_UINT64_T(input + length - 8) ^
+								  ((XXH3_READ_UINT64_T(secret + 40) ^ XXH3_READ_UINT64_T(secret + 48)) - seed);
+			return XXH3_avalanche(length + XXH3_SWAP_UINT64_T(low) + high + XXH3_multiply_fold(low, high));
+		}
+		else if (4 <= length)
+		{
+			seed ^= (uint64_t)XXH3_SWAP_UINT32_T((uint32_t)seed) << 32;
+			const uint64_t value = (uint64_t)XXH3_READ_UINT32_T(input + length - 4) +
+								   ((uint64_t)XXH3_READ_UINT32_T(input) << 32);
+			return XXH3_rrmxmx(value ^ ((XXH3_READ_UINT64_T(secret + 8) ^ XXH3_READ_UINT64_T(secret + 16)) - seed),
+							   length);
+		}
+		else if (0 < length)
+		{
+			const uint32_t combined = ((uint32_t)input[0] << 16) | ((uint32_t)input[length >> 1] << 24) |
+									  (uint32_t)input[length - 1] | ((uint32_t)length << 8);
+			return XXH64_avalanche(combined ^ ((uint64_t)(XXH3_READ_UINT32_T(secret) ^
+											   XXH3_READ_UINT32_T(secret + 4)) + seed));
+		}
+
+		return XXH64_avalanche(seed ^ XXH3_READ_UINT64_T(secret + 56) ^ XXH3_READ_UINT64_T(secret + 64));
+	}
+
+	uint64_t output = length * PRIME64_1;
+
+	if (length <= 128)
+	{
+		for (uint8_t i = (uint8_t)((length - 1) / 32) + 1; 0 < i; --i)
+		{
+			output += XXH3_mix_16(input + 16 * (i - 1), secret + 32 * (i - 1), seed);
+			output += XXH3_mix_16(input + length - 16 * i, secret + 32 * (i - 1) + 16, seed);
+		}
+
+		return XXH3_avalanche(output);
+	}
+
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		output += XXH3_mix_16(input + 16 * i, secret + 16 * i, seed);
+	}
+
+	output = XXH3_avalanche(output);
+	uint64_t tail = XXH3_mix_16(input + length - 16, secret + 136 - XXH3_MID_SIZE_LAST, seed);
+
+	for (uint8_t i = 8; i < length / 16; ++i)
+	{
+		tail += XXH3_mix_16(input + 16 * i, secret + 16 * (i - 8) + XXH3_MID_SIZE_START, seed);
+	}
+
+	return XXH3_avalanche(output + tail);
+}
+
+void XXH3_128_short(const uint8_t* input, uint64_t length, const uint8_t* secret, uint64_t seed,
+					uint64_t* output)
+{
+	if (length <= 16)
+	{
+		if (8 < length)
+		{
+			uint64_t high = XXH3_READ_UINT64_T(input + length - 8);
+			uint64_t m_high;
+			uint64_t m_low = XXH3_multiply(
+								 XXH3_READ_UINT64_T(input) ^ high ^
+								 ((XXH3_READ_UINT64_T(secret + 32) ^ XXH3_READ_UINT64_T(secret + 40)) - seed),
+								 PRIME64_1, &m_high);
+			m_low += (length - 1) << 54;
+			high ^= (XXH3_READ_UINT64_T(secret + 48) ^ XXH3_READ_UINT64_T(secret + 56)) + seed;
+			m_high += high + (uint64_t)(uint32_t)high * (PRIME32_2 - 1);
+			m_low ^= XXH3_SWAP_UINT64_T(m_high);
+			/**/
+			output[0] = XXH3_multiply(m_low, PRIME64_2, &output[1]);
+			output[1] += m_high * PRIME64_2;
+			output[0] = XXH3_avalanche(output[0]);
+			output[1] = XXH3_avalanche(output[1]);
+		}
+		else if (4 <= length)
+		{
+			seed ^= (uint64_t)XXH3_SWAP_UINT32_T((uint32_t)seed) << 32;
+			const uint64_t value = (uint64_t)XXH3_READ_UINT32_T(input) +
+								   ((uint64_t)XXH3_READ_UINT32_T(input + length - 4) << 32);
+			output[0] = XXH3_multiply(
+							value ^ ((XXH3_READ_UINT64_T(secret + 16) ^ XXH3_READ_UINT64_T(secret + 24)) + seed),
+							PRIME64_1 + (length << 2), &output[1]);
+			output[1] += output[0] << 1;
+			output[0] ^= output[1] >> 3;
+			output[0] ^= output[0] >> 35;
+			output[0] *= PRIME_MX2;
+			output[0] ^= output[0] >> 28;
+			output[1] = XXH3_avalanche(output[1]);
+		}
+		else if (0 < length)
+		{
+			const uint32_t combined = ((uint32_t)input[0] << 16) | ((uint32_t)input[length >> 1] << 24) |
+									  (uint32_t)input[length - 1] | ((uint32_t)length << 8);
+			const uint32_t swapped = XXH3_SWAP_UINT32_T(combined);
+			output[0] = XXH64_avalanche(combined ^ ((uint64_t)(XXH3_READ_UINT32_T(secret) ^
+												   XXH3_READ_UINT32_T(secret + 4)) + seed));
+			output[1] = XXH64_avalanche(ROTATE_LEFT_UINT32_T(swapped, 13) ^
+										((uint64_t)(XXH3_READ_UINT32_T(secret + 8) ^
+													XXH3_READ_UINT32_T(secret + 12)) - seed));
+		}
+		else
+		{
+			output[0] = XXH64_avalanche(seed ^ XXH3_READ_UINT64_T(secret + 64) ^ XXH3_READ_UINT64_T(secret + 72));
+			output[1] = XXH64_avalanche(seed ^ XXH3_READ_UINT64_T(secret + 80) ^ XXH3_READ_UINT64_T(secret + 88));
+		}
+
+		return;
+	}
+
+	output[0] = length * PRIME64_1;
+	output[1] = 0;
+
+	if (length <= 128)
+	{
+		for (uint8_t i = (uint8_t)((length - 1) / 32) + 1; 0 < i; --i)
+		{
+			XXH3_mix_32(output, input + 16 * (i - 1), input + length - 16 * i, secret + 32 * (i - 1), seed);
+		}
+	}
+	else
+	{
+		uint16_t i;
+
+		for (i = 32; i < 160; i += 32)
+		{
+			XXH3_mix_32(output, input + i - 32, input + i - 16, secret + i - 32, seed);
+		}
+
+		output[0] = XXH3_avalanche(output[0]);
+		output[1] = XXH3_avalanche(output[1]);
+
+		for (i = 160; i <= length; i += 32)
+		{
+			XXH3_mix_32(output, input + i - 32, input + i - 16, secret + XXH3_MID_SIZE_START + i - 160, seed);
+		}
+
+		XXH3_mix_32(output, input + length - 16, input + length - 32,
+					secret + 136 - XXH3_MID_SIZE_LAST - 16, 0 - seed);
+	}
+
+	const uint64_t low = output[0] + output[1];
+	const uint64_t high = output[0] * PRIME64_1 + output[1] * PRIME64_4 + (length - seed) * PRIME64_2;
+	output[0] = XXH3_avalanche(low);
+	output[1] = 0 - XXH3_avalanche(high);
+}
+
+void XXH3_accumulate_portable(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret,
+							  ptrdiff_t stripes)
+{
+	for (; 0 < stripes; --stripes, input += XXH3_STRIPE_LENGTH, secret += XXH3_SECRET_CONSUME_RATE)
+	{
+		for (uint8_t i = 0; i < 8; ++i)
+		{
+			const uint64_t value = XXH3_READ_UINT64_T(input + 8 * i);
+			const uint64_t key = value ^ XXH3_READ_UINT64_T(secret + 8 * i);
+			accumulators[i ^ 1] += value;
+			accumulators[i] += (key & 0xFFFFFFFF) * (key >> 32);
+		}
+	}
+}
+
+void XXH3_scramble_portable(uint64_t* accumulators, const uint8_t* secret)
+{
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		uint64_t value = accumulators[i];
+		value ^= value >> 47;
+		value ^= XXH3_READ_UINT64_T(secret + 8 * i);
+		accumulators[i] = value * PRIME32_1;
+	}
+}
+#if defined(XXH3_X86)
+/*NOTE: unaligned loads are used, so input, secret and accumulators may have any address;
+  lanes are little-endian at memory as x86 is.*/
+XXH3_TARGET("sse2")
+void XXH3_accumulate_sse2(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret,
+						  ptrdiff_t stripes)
+{
+	__m128i a[4];
+
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		a[i] = _mm_loadu_si128((const __m128i*)accumulators + i);
+	}
+
+	for (; 0 < stripes; --stripes, input += XXH3_STRIPE_LENGTH, secret += XXH3_SECRET_CONSUME_RATE)
+	{
+		for (uint8_t i = 0; i < 4; ++i)
+		{
+			const __m128i value = _mm_loadu_si128((const __m128i*)input + i);
+			const __m128i key = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)secret + i));
+			const __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+			a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+			a[i] = _mm_add_epi64(a[i], product);
+		}
+	}
+
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		_mm_storeu_si128((__m128i*)accumulators + i, a[i]);
+	}
+}
+
+XXH3_TARGET("sse2")
+void XXH3_scramble_sse2(uint64_t* accumulators, const uint8_t* secret)
+{
+	const __m128i prime = _mm_set1_epi32((int)PRIME32_1);
+
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		__m128i value = _mm_loadu_si128((const __m128i*)accumulators + i);
+		value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+		value = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)secret + i));
+		const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+		value = _mm_add_epi64(_mm_mul_epu32(value, prime), _mm_slli_epi64(high, 32));
+		_mm_storeu_si128((__m128i*)accumulators + i, value);
+	}
+}
+
+XXH3_TARGET("avx2")
+void XXH3_accumulate_avx2(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret,
+						  ptrdiff_t stripes)
+{
+	__m256i a[2];
+	a[0] = _mm256_loadu_si256((const __m256i*)accumulators);
+	a[1] = _mm256_loadu_si256((const __m256i*)accumulators + 1);
+
+	for (; 0 < stripes; --stripes, input += XXH3_STRIPE_LENGTH, secret += XXH3_SECRET_CONSUME_RATE)
+	{
+		for (uint8_t i = 0; i < 2; ++i)
+		{
+			const __m256i value = _mm256_loadu_si256((const __m256i*)input + i);
+			const __m256i key = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)secret + i));
+			const __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+			a[i] = _mm256_add_epi64(a[i], _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+			a[i] = _mm256_add_epi64(a[i], product);
+		}
+	}
+
+	_mm256_storeu_si256((__m256i*)accumulators, a[0]);
+	_mm256_storeu_si256((__m256i*)accumulators + 1, a[1]);
+}
+
+XXH3_TARGET("avx2")
+void XXH3_scramble_avx2(uint64_t* accumulators, const uint8_t* secret)
+{
+	const __m256i prime = _mm256_set1_epi32((int)PRIME32_1);
+
+	for (uint8_t i = 0; i < 2; ++i)
+	{
+		__m256i value = _mm256_loadu_si256((const __m256i*)accumulators + i);
+		value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+		value = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)secret + i));
+		const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+		value = _mm256_add_epi64(_mm256_mul_epu32(value, prime), _mm256_slli_epi64(high, 32));
+		_mm256_storeu_si256((__m256i*)accumulators + i, value);
+	}
+}
+
+enum XXH3_KERNEL
+{
+	XXH3_UNKNOWN_KERNEL, XXH3_PORTABLE, XXH3_SSE2, XXH3_AVX2
+};
+
+static uint8_t xxh3_kernel = XXH3_UNKNOWN_KERNEL;
+
+uint8_t XXH3_get_kernel()
+{
+	if (XXH3_UNKNOWN_KERNEL != xxh3_kernel)
+	{
+		return xxh3_kernel;
+	}
+
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int count = info[0];
+	__cpuid(info, 1);
+	const uint8_t sse2 = 0 != (info[3] & (1 << 26));
+	/*NOTE: AVX registers also should be saved by the operating system.*/
+	const uint8_t avx = 0 != (info[2] & (1 << 27)) && 0 != (info[2] & (1 << 28)) &&
+						6 == (_xgetbv(0) & 6);
+	uint8_t avx2 = 0;
+
+	if (7 <= count)
+	{
+		__cpuidex(info, 7, 0);
+		avx2 = avx && 0 != (info[1] & (1 << 5));
+	}
+
+#else
+	__builtin_cpu_init();
+	const uint8_t sse2 = 0 != __builtin_cpu_supports("sse2");
+	const uint8_t avx2 = 0 != __builtin_cpu_supports("avx2");
+#endif
+	xxh3_kernel = avx2 ? XXH3_AVX2 : (sse2 ? XXH3_SSE2 : XXH3_PORTABLE);
+	return xxh3_kernel;
+}
+#endif
+void XXH3_accumulate(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret,
+					 ptrdiff_t stripes)
+{
+#if defined(XXH3_X86)
+	const uint8_t kernel = XXH3_get_kernel();
+
+	if (XXH3_AVX2 == kernel)
+	{
+		XXH3_accumulate_avx2(accumulators, input, secret, stripes);
+		return;
+	}
+	else if (XXH3_SSE2 == kernel)
+	{
+		XXH3_accumulate_sse2(accumulators, input, secret, stripes);
+		return;
+	}
+
+#endif
+	/*TODO: NEON kernel.*/
+	XXH3_accumulate_portable(accumulators, input, secret, stripes);
+}
+
+void XXH3_scramble(uint64_t* accumulators, const uint8_t* secret)
+{
+#if defined(XXH3_X86)
+	const uint8_t kernel = XXH3_get_kernel();
+
+	if (XXH3_AVX2 == kernel)
+	{
+		XXH3_scramble_avx2(accumulators, secret);
+		return;
+	}
+	else if (XXH3_SSE2 == kernel)
+	{
+		XXH3_scramble_sse2(accumulators, secret);
+		return;
+	}
+
+#endif
+	XXH3_scramble_portable(accumulators, secret);
+}
+
+void XXH3_consume_stripes(uint64_t* accumulators, const uint8_t* input, ptrdiff_t stripes,
+						  const uint8_t* secret)
+{
+	uint64_t* stripes_at_block = accumulators + 8;
+
+	while (0 < stripes)
+	{
+		const ptrdiff_t count = MIN(stripes, (ptrdiff_t)(XXH3_STRIPES_PER_BLOCK - *stripes_at_block));
+		XXH3_accumulate(accumulators, input, secret + *stripes_at_block * XXH3_SECRET_CONSUME_RATE, count);
+		/**/
+		input += count * XXH3_STRIPE_LENGTH;
+		stripes -= count;
+		*stripes_at_block += count;
+
+		if (XXH3_STRIPES_PER_BLOCK == *stripes_at_block)
+		{
+			XXH3_scramble(accumulators, secret + XXH3_SECRET_LIMIT);
+			*stripes_at_block = 0;
+		}
+	}
+}
+
+uint64_t XXH3_merge(const uint64_t* accumulators, const uint8_t* secret, uint64_t start)
+{
+	for (uint8_t i = 0; i < 8; i += 2)
+	{
+		start += XXH3_multiply_fold(accumulators[i] ^ XXH3_READ_UINT64_T(secret + 8 * i),
+									accumulators[i + 1] ^ XXH3_READ_UINT64_T(secret + 8 * i + 8));
+	}
+
+	return XXH3_avalanche(start);
+}
+
+uint8_t hash_algorithm_XXH3_init(uint64_t seed, uint64_t* accumulators, uint8_t* secret)
+{
+	if (NULL == accumulators ||
+		NULL == secret)
+	{
+		return 0;
+	}
+
+	accumulators[0] = PRIME32_3;
+	accumulators[1] = PRIME64_1;
+	accumulators[2] = PRIME64_2;
+	accumulators[3] = PRIME64_3;
+	accumulators[4] = PRIME64_4;
+	accumulators[5] = PRIME32_2;
+	accumulators[6] = PRIME64_5;
+	accumulators[7] = PRIME32_1;
+	accumulators[8] = 0;
+	accumulators[9] = 0;
+
+	/*NOTE: long input use the secret derived from the seed, with zero seed it is equal to the default one.*/
+	for (uint8_t i = 0; i < XXH3_SECRET_LENGTH; i += 16)
+	{
+		if (!hash_algorithm_uint64_t_to_uint8_t_array(XXH3_READ_UINT64_T(XXH3_SECRET + i) + seed, secret + i) ||
+			!hash_algorithm_uint64_t_to_uint8_t_array(XXH3_READ_UINT64_T(XXH3_SECRET + i + 8) - seed, secret + i + 8))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t hash_algorithm_XXH3_core(
+	const uint8_t* start, const uint8_t* finish,
+	uint8_t* queue, uint16_t* queue_size,
+	uint64_t* accumulators, const uint8_t* secret)
+{
+	if (!start ||
+		!finish ||
+		!queue ||
+		!queue_size ||
+		!accumulators ||
+		!secret ||
+		finish < start ||
+		XXH3_QUEUE_LENGTH < *queue_size)
+	{
+		return 0;
+	}
+
+	accumulators[9] += (uint64_t)(finish - start);
+
+	if (finish - start <= XXH3_QUEUE_LENGTH - *queue_size)
+	{
+		MEM_CPY_C(queue + *queue_size, start, finish - start);
+		*queue_size += (uint16_t)(finish - start);
+		return 1;
+	}
+
+	/*NOTE: queue is consumed only when more input follows, so last stripe is always kept for the final.*/
+	if (*queue_size)
+	{
+		const ptrdiff_t size = XXH3_QUEUE_LENGTH - *queue_size;
+		MEM_CPY_C(queue + *queue_size, start, size);
+		start += size;
+		XXH3_consume_stripes(accumulators, queue, XXH3_QUEUE_LENGTH / XXH3_STRIPE_LENGTH, secret);
+		*queue_size = 0;
+	}
+
+	if (XXH3_QUEUE_LENGTH < finish - start)
+	{
+		const ptrdiff_t stripes = (finish - start - 1) / XXH3_STRIPE_LENGTH;
+		XXH3_consume_stripes(accumulators, start, stripes, secret);
+		start += stripes * XXH3_STRIPE_LENGTH;
+		MEM_CPY_C(queue + XXH3_QUEUE_LENGTH - XXH3_STRIPE_LENGTH, start - XXH3_STRIPE_LENGTH,
+				  XXH3_STRIPE_LENGTH);
+	}
+
+	MEM_CPY_C(queue, start, finish - start);
+	*queue_size = (uint16_t)(finish - start);
+	return 1;
+}
+
+uint8_t XXH3_final_long(const uint8_t* queue, uint16_t queue_size,
+						const uint64_t* accumulators, const uint8_t* secret,
+						uint64_t* output)
+{
+	uint8_t last_stripe[XXH3_STRIPE_LENGTH];
+	const uint8_t* last_stripe_ptr = last_stripe;
+	MEM_CPY_C(output, accumulators, XXH3_ACCUMULATORS_COUNT * sizeof(uint64_t));
+
+	if (XXH3_STRIPE_LENGTH <= queue_size)
+	{
+		XXH3_consume_stripes(output, queue, (queue_size - 1) / XXH3_STRIPE_LENGTH, secret);
+		last_stripe_ptr = queue + queue_size - XXH3_STRIPE_LENGTH;
+	}
+	else
+	{
+		const uint8_t size = (uint8_t)(XXH3_STRIPE_LENGTH - queue_size);
+		MEM_CPY_C(last_stripe, queue + XXH3_QUEUE_LENGTH - size, size);
+		MEM_CPY_C(last_stripe + size, queue, queue_size);
+	}
+
+	XXH3_accumulate(output, last_stripe_ptr, secret + XXH3_SECRET_LIMIT - XXH3_SECRET_LAST_STRIPE, 1);
+	return 1;
+}
+
+uint8_t hash_algorithm_XXH3_64_final(
+	const uint8_t* queue, uint16_t queue_size,
+	const uint64_t* accumulators, const uint8_t* secret,
+	uint64_t seed, uint64_t* output)
+{
+	if (!queue ||
+		!accumulators ||
+		!secret ||
+		!output ||
+		XXH3_QUEUE_LENGTH < queue_size)
+	{
+		return 0;
+	}
+
+	const uint64_t length = accumulators[9];
+
+	if (length <= XXH3_MID_SIZE_MAX)
+	{
+		*output = XXH3_64_short(queue, length, XXH3_SECRET, seed);
+		return 1;
+	}
+
+	uint64_t out[XXH3_ACCUMULATORS_COUNT];
+
+	if (!XXH3_final_long(queue, queue_size, accumulators, secret, out))
+	{
+		return 0;
+	}
+
+	*output = XXH3_merge(out, secret + XXH3_SECRET_MERGE, length * PRIME64_1);
+	return 1;
+}
+
+uint8_t hash_algorithm_XXH3_128_final(
+	const uint8_t* queue, uint16_t queue_size,
+	const uint64_t* accumulators, const uint8_t* secret,
+	uint64_t seed, uint64_t* output)
+{
+	if (!queue ||
+		!accumulators ||
+		!secret ||
+		!output ||
+		XXH3_QUEUE_LENGTH < queue_size)
+	{
+		return 0;
+	}
+
+	const uint64_t length = accumulators[9];
+
+	if (length <= XXH3_MID_SIZE_MAX)
+	{
+		XXH3_128_short(queue, length, XXH3_SECRET, seed, output);
+		return 1;
+	}
+
+	uint64_t out[XXH3_ACCUMULATORS_COUNT];
+
+	if (!XXH3_final_long(queue, queue_size, accumulators, secret, out))
+	{
+		return 0;
+	}
+
+	output[0] = XXH3_merge(out, secret + XXH3_SECRET_MERGE, length * PRIME64_1);
+	output[1] = XXH3_merge(out, secret + XXH3_SECRET_LENGTH - 8 * sizeof(uint64_t) - XXH3_SECRET_MERGE,
+						   ~(length * PRIME64_2));
+	return 1;
+}
+
+uint8_t hash_algorithm_XXH3(
+	const uint8_t* start, const uint8_t* finish,
+	uint64_t seed, uint8_t is_128, uint64_t* output)
+{
+	if (!start ||
+		!finish ||
+		!output ||
+		finish < start)
+	{
+		return 0;
+	}
+
+	if (finish - start <= XXH3_MID_SIZE_MAX)
+	{
+		if (is_128)
+		{
+			XXH3_128_short(start, finish - start, XXH3_SECRET, seed, output);
+		}
+		else
+		{
+			*output = XXH3_64_short(start, finish - start, XXH3_SECRET, seed);
+		}
+
+		return 1;
+	}
+
+	uint8_t queue[XXH3_QUEUE_LENGTH];
+	uint16_t queue_size = 0;
+	uint64_t accumulators[XXH3_ACCUMULATORS_COUNT];
+	uint8_t secret[XXH3_SECRET_LENGTH];
+
+	if (!hash_algorithm_XXH3_init(seed, accumulators, secret) ||
+		!hash_algorithm_XXH3_core(start, finish, queue, &queue_size, accumulators, secret))
+	{
+		return 0;
+	}
+
+	return is_128 ?
+		   hash_algorithm_XXH3_128_final(queue, queue_size, accumulators, secret, seed, output) :
+		   hash_algorithm_XXH3_64_final(queue, queue_size, accumulators, secret, seed, output);
+}
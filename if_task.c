@@ -11,6 +11,7 @@
 #include "common.h"
 #include "conversion.h"
 #include "interpreter.h"
+#include "project.h"
 #include "xml.h"
 
 #include <stddef.h>
@@ -63,7 +64,8 @@ uint8_t if_evaluate_task(
 		return 0;
 	}
 
-	if (!xml_get_sub_nodes_elements(attributes_finish, element_finish, NULL, test_in_a_buffer))
+	if (!xml_get_sub_nodes_elements(
+			project_get_xml_index(the_project), attributes_finish, element_finish, NULL, test_in_a_buffer))
 	{
 		return 1;
 	}
@@ -312,7 +312,7 @@ uint8_t interpreter_actualize_property_value(
 	uint8_t code_in_a_buffer_[BUFFER_SIZE_OF];
 	void* code_in_a_buffer = (void*)code_in_a_buffer_;
 
-	if (!buffer_init(code_in_a_buffer, BUFFER_SIZE_OF))
+	if (!buffer_init_at_arena(code_in_a_buffer, BUFFER_SIZE_OF))
 	{
 		return 0;
 	}
@@ -348,7 +348,7 @@ uint8_t interpreter_get_value_for_argument(
 	uint8_t value_buffer[BUFFER_SIZE_OF];
 	void* value = (void*)value_buffer;
 
-	if (!buffer_init(value, BUFFER_SIZE_OF))
+	if (!buffer_init_at_arena(value, BUFFER_SIZE_OF))
 	{
 		return 0;
 	}
@@ -536,14 +536,6 @@ uint8_t interpreter_evaluate_function(const void* the_project, const void* the_t
 									  const struct range* function,
 									  void* return_of_function, uint8_t verbose)
 {
-	uint8_t values_buffer[BUFFER_SIZE_OF];
-	void* values = (void*)values_buffer;
-
-	if (!buffer_init(values, BUFFER_SIZE_OF))
-	{
-		return 0;
-	}
-
 	struct range name_space;
 
 	struct range name;
@@ -555,10 +547,33 @@ uint8_t interpreter_evaluate_function(const void* the_project, const void* the_t
 		return 0;
 	}
 
+	return interpreter_evaluate_disassembled_function(
+			   the_project, the_target, &name_space, &name, &arguments_area,
+			   return_of_function, verbose);
+}
+
+uint8_t interpreter_evaluate_disassembled_function(
+	const void* the_project, const void* the_target,
+	const struct range* name_space_, const struct range* name_,
+	const struct range* arguments_area,
+	void* return_of_function, uint8_t verbose)
+{
+	uint8_t values_buffer[BUFFER_SIZE_OF];
+	void* values = (void*)values_buffer;
+
+	if (!buffer_init_at_arena(values, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	struct range name_space = *name_space_;
+
+	struct range name = *name_;
+
 	uint8_t values_count;
 
 	if (!interpreter_get_values_for_arguments(
-			the_project, the_target, &arguments_area,
+			the_project, the_target, arguments_area,
 			values, &values_count, verbose))
 	{
 		buffer_release_with_inner_buffers(values);
@@ -706,7 +721,7 @@ uint8_t interpreter_evaluate_function(const void* the_project, const void* the_t
 				uint8_t full_path_buffer[BUFFER_SIZE_OF];
 				void* full_path = (void*)full_path_buffer;
 
-				if (!buffer_init(full_path, BUFFER_SIZE_OF))
+				if (!buffer_init_at_arena(full_path, BUFFER_SIZE_OF))
 				{
 					values_count = 0;
 					break;
@@ -834,41 +849,68 @@ uint8_t interpreter_evaluate_function(const void* the_project, const void* the_t
 	return values_count;
 }
 
-uint8_t interpreter_evaluate_code(
-	const void* the_project, const void* the_target,
-	const void* the_current_property, const struct range* code,
-	void* output, uint8_t verbose)
+struct interpreter_code_node
 {
-	if (range_is_null_or_empty(code) || NULL == output)
-	{
-		return 0;
-	}
+	ptrdiff_t literal_start;
+	ptrdiff_t literal_finish;
+	ptrdiff_t function_start;
+	ptrdiff_t function_finish;
+	ptrdiff_t name_space_start;
+	ptrdiff_t name_space_finish;
+	ptrdiff_t name_start;
+	ptrdiff_t name_finish;
+	ptrdiff_t arguments_area_start;
+	ptrdiff_t arguments_area_finish;
+	uint8_t is_function;
+	uint8_t is_disassembled;
+};
 
-	uint8_t return_of_function_buffer[BUFFER_SIZE_OF];
-	void* return_of_function = (void*)return_of_function_buffer;
+struct interpreter_compiled_code
+{
+	uint32_t hash;
+	ptrdiff_t text_position;
+	ptrdiff_t text_length;
+	ptrdiff_t node_position;
+	ptrdiff_t nodes_count;
+};
+
+#define CODE_TEXTS_POSITION		0
+#define CODE_RECORDS_POSITION	1
+#define CODE_NODES_POSITION		2
+#define CODE_INDEX_POSITION		3
+#define CODE_COUNT_OF_POSITIONS	(CODE_INDEX_POSITION + 1)
+
+#define CODE_MINIMAL_INDEX_COUNT	64
+#define CODE_MAXIMUM_RECORDS_COUNT	8192
 
-	if (!buffer_init(return_of_function, BUFFER_SIZE_OF))
+uint8_t interpreter_is_code_contains_expression(const struct range* code)
+{
+	for (const uint8_t* pos = code->start; pos + CALL_OF_EXPRESSION_START_LENGTH <= code->finish; ++pos)
 	{
-		return 0;
+		if (0 == memcmp(pos, call_of_expression_start, CALL_OF_EXPRESSION_START_LENGTH))
+		{
+			return 1;
+		}
 	}
 
+	return 0;
+}
+
+uint8_t interpreter_compile_code(const struct range* code, void* nodes, ptrdiff_t* nodes_count)
+{
+	struct interpreter_code_node node;
 	const uint8_t* previous_pos = code->start;
 	struct range function;
+	*nodes_count = 0;
 
 	for (function.start = code->start; function.start + CALL_OF_EXPRESSION_START_LENGTH <= code->finish;)
 	{
 		if (0 != memcmp(function.start, call_of_expression_start, CALL_OF_EXPRESSION_START_LENGTH))
 		{
-			function.start = string_enumerate(function.start, code->finish, NULL);
+			++function.start;
 			continue;
 		}
 
-		if (!buffer_resize(return_of_function, 0))
-		{
-			buffer_release(return_of_function);
-			return 0;
-		}
-
 		function.finish = function.start;
 		uint32_t char_set;
 
@@ -895,50 +937,343 @@ uint8_t interpreter_evaluate_code(
 		}
 
 		if (NULL == function.finish)
+		{
+			return 0;
+		}
+
+		node.literal_start = previous_pos - code->start;
+		node.literal_finish = function.start - code->start;
+		function.start += CALL_OF_EXPRESSION_START_LENGTH;
+		node.function_start = function.start - code->start;
+		node.function_finish = function.finish - code->start;
+		node.is_function = 1;
+		/**/
+		struct range name_space;
+		struct range name;
+		struct range arguments_area;
+		node.is_disassembled = interpreter_disassemble_function(
+								   &function, &name_space, &name, &arguments_area);
+
+		if (node.is_disassembled)
+		{
+			node.name_space_start = name_space.start - code->start;
+			node.name_space_finish = name_space.finish - code->start;
+			node.name_start = name.start - code->start;
+			node.name_finish = name.finish - code->start;
+			node.arguments_area_start = arguments_area.start - code->start;
+			node.arguments_area_finish = arguments_area.finish - code->start;
+		}
+
+		if (!buffer_append(nodes, (const void*)&node, sizeof(struct interpreter_code_node)))
+		{
+			return 0;
+		}
+
+		++(*nodes_count);
+		previous_pos = string_enumerate(function.finish, code->finish, NULL);
+
+		if (NULL == previous_pos)
+		{
+			previous_pos = code->finish;
+		}
+
+		function.start = previous_pos;
+	}
+
+	node.literal_start = previous_pos - code->start;
+	node.literal_finish = code->finish - code->start;
+	node.is_function = 0;
+	node.is_disassembled = 0;
+
+	if (!buffer_append(nodes, (const void*)&node, sizeof(struct interpreter_code_node)))
+	{
+		return 0;
+	}
+
+	++(*nodes_count);
+	return 1;
+}
+
+uint32_t interpreter_get_code_hash(const struct range* code)
+{
+	uint32_t hash = 2166136261;
+
+	for (const uint8_t* pos = code->start; pos < code->finish; ++pos)
+	{
+		hash ^= *pos;
+		hash *= 16777619;
+	}
+
+	return hash;
+}
+
+uint8_t interpreter_code_index_insert(void* index, uint32_t hash, ptrdiff_t record_position)
+{
+	const ptrdiff_t capacity = buffer_size(index) / sizeof(ptrdiff_t);
+
+	if (capacity < 1)
+	{
+		return 0;
+	}
+
+	ptrdiff_t* slots = (ptrdiff_t*)buffer_data(index, 0);
+	const ptrdiff_t mask = capacity - 1;
+	ptrdiff_t slot = hash & mask;
+
+	while (0 != slots[slot])
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	slots[slot] = record_position + 1;
+	return 1;
+}
+
+uint8_t interpreter_code_index_rebuild(void* cache, ptrdiff_t capacity)
+{
+	void* index = buffer_buffer_data(cache, CODE_INDEX_POSITION);
+	const void* records = buffer_buffer_data(cache, CODE_RECORDS_POSITION);
+
+	if (!buffer_resize(index, 0) ||
+		!buffer_append(index, NULL, capacity * sizeof(ptrdiff_t)))
+	{
+		return 0;
+	}
+
+	memset(buffer_data(index, 0), 0, capacity * sizeof(ptrdiff_t));
+	ptrdiff_t i = 0;
+	const struct interpreter_compiled_code* record;
+
+	while (NULL != (record = (const struct interpreter_compiled_code*)buffer_data(
+								 records, sizeof(struct interpreter_compiled_code) * i)))
+	{
+		if (!interpreter_code_index_insert(index, record->hash, i++))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t interpreter_get_compiled_code(
+	const void* the_project, const struct range* code,
+	void* local_nodes, void** nodes, ptrdiff_t* node_position, ptrdiff_t* nodes_count)
+{
+	void* cache = project_get_compiled_code_cache(the_project);
+
+	if (NULL == cache)
+	{
+		*nodes = local_nodes;
+		*node_position = 0;
+		return interpreter_compile_code(code, local_nodes, nodes_count);
+	}
+
+	if (!buffer_size(cache) &&
+		!common_get_attributes_and_arguments_for_task(
+			NULL, NULL, CODE_COUNT_OF_POSITIONS, NULL, NULL, NULL, cache))
+	{
+		return 0;
+	}
+
+	void* texts = buffer_buffer_data(cache, CODE_TEXTS_POSITION);
+	void* records = buffer_buffer_data(cache, CODE_RECORDS_POSITION);
+	void* index = buffer_buffer_data(cache, CODE_INDEX_POSITION);
+	const ptrdiff_t code_length = range_size(code);
+	const uint32_t hash = interpreter_get_code_hash(code);
+	/**/
+	const ptrdiff_t capacity = buffer_size(index) / sizeof(ptrdiff_t);
+
+	if (0 < capacity)
+	{
+		const ptrdiff_t* slots = (const ptrdiff_t*)buffer_data(index, 0);
+		const ptrdiff_t mask = capacity - 1;
+		ptrdiff_t slot = hash & mask;
+
+		while (0 != slots[slot])
+		{
+			const struct interpreter_compiled_code* record =
+				(const struct interpreter_compiled_code*)buffer_data(
+					records, sizeof(struct interpreter_compiled_code) * (slots[slot] - 1));
+
+			if (hash == record->hash &&
+				code_length == record->text_length &&
+				0 == memcmp(buffer_data(texts, record->text_position), code->start, code_length))
+			{
+				*nodes = buffer_buffer_data(cache, CODE_NODES_POSITION);
+				*node_position = record->node_position;
+				*nodes_count = record->nodes_count;
+				return 1;
+			}
+
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	const ptrdiff_t count = buffer_size(records) / sizeof(struct interpreter_compiled_code);
+
+	if (CODE_MAXIMUM_RECORDS_COUNT <= count)
+	{
+		*nodes = local_nodes;
+		*node_position = 0;
+		return interpreter_compile_code(code, local_nodes, nodes_count);
+	}
+
+	struct interpreter_compiled_code record;
+
+	*nodes = buffer_buffer_data(cache, CODE_NODES_POSITION);
+
+	record.hash = hash;
+
+	record.text_position = buffer_size(texts);
+
+	record.text_length = code_length;
+
+	record.node_position = buffer_size(*nodes) / sizeof(struct interpreter_code_node);
+
+	if (!interpreter_compile_code(code, *nodes, &record.nodes_count))
+	{
+		buffer_resize(*nodes, sizeof(struct interpreter_code_node) * record.node_position);
+		return 0;
+	}
+
+	if (!buffer_append(texts, code->start, code_length) ||
+		!buffer_append(records, (const void*)&record, sizeof(struct interpreter_compiled_code)))
+	{
+		return 0;
+	}
+
+	*node_position = record.node_position;
+	*nodes_count = record.nodes_count;
+
+	if (capacity < 2 * (count + 1))
+	{
+		return interpreter_code_index_rebuild(cache, MAX(CODE_MINIMAL_INDEX_COUNT, 2 * capacity));
+	}
+
+	return interpreter_code_index_insert(index, hash, count);
+}
+
+uint8_t interpreter_evaluate_code(
+	const void* the_project, const void* the_target,
+	const void* the_current_property, const struct range* code,
+	void* output, uint8_t verbose)
+{
+	if (range_is_null_or_empty(code) || NULL == output)
+	{
+		return 0;
+	}
+
+	if (!interpreter_is_code_contains_expression(code))
+	{
+		return buffer_append(output, code->start, range_size(code));
+	}
+
+	uint8_t local_nodes_buffer[BUFFER_SIZE_OF];
+	void* local_nodes = (void*)local_nodes_buffer;
+
+	if (!buffer_init_at_arena(local_nodes, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	void* nodes = NULL;
+	ptrdiff_t node_position = 0;
+	ptrdiff_t nodes_count = 0;
+
+	if (!interpreter_get_compiled_code(the_project, code, local_nodes, &nodes, &node_position, &nodes_count))
+	{
+		buffer_release(local_nodes);
+		return 0;
+	}
+
+	uint8_t return_of_function_buffer[BUFFER_SIZE_OF];
+	void* return_of_function = (void*)return_of_function_buffer;
+
+	if (!buffer_init_at_arena(return_of_function, BUFFER_SIZE_OF))
+	{
+		buffer_release(local_nodes);
+		return 0;
+	}
+
+	for (ptrdiff_t i = node_position, count = node_position + nodes_count; i < count; ++i)
+	{
+		/*NOTE: nodes can be reallocated by the nested evaluation, so node is copied.*/
+		const struct interpreter_code_node* node_at_cache =
+			(const struct interpreter_code_node*)buffer_data(nodes, sizeof(struct interpreter_code_node) * i);
+
+		if (NULL == node_at_cache)
 		{
 			buffer_release(return_of_function);
+			buffer_release(local_nodes);
 			return 0;
 		}
 
-		if (previous_pos < function.start && !buffer_append(output, previous_pos, function.start - previous_pos))
+		const struct interpreter_code_node node = *node_at_cache;
+
+		if (node.literal_start < node.literal_finish &&
+			!buffer_append(output, code->start + node.literal_start, node.literal_finish - node.literal_start))
 		{
 			buffer_release(return_of_function);
+			buffer_release(local_nodes);
+			return 0;
+		}
+
+		if (!node.is_function)
+		{
+			continue;
+		}
+
+		if (!buffer_resize(return_of_function, 0))
+		{
+			buffer_release(return_of_function);
+			buffer_release(local_nodes);
 			return 0;
 		}
 
-		function.start += CALL_OF_EXPRESSION_START_LENGTH;
 		void* the_property = NULL;
 
 		if (project_property_exists(
-				the_project, function.start,
-				(uint8_t)range_size(&function), &the_property, verbose))
+				the_project, code->start + node.function_start,
+				(uint8_t)(node.function_finish - node.function_start), &the_property, verbose))
 		{
-			if (!property_get_by_pointer(the_property, return_of_function))
+			if (!property_get_by_pointer(the_property, return_of_function) ||
+				(NULL != the_current_property && the_current_property == the_property) ||
+				!interpreter_actualize_property_value(
+					the_project, the_target, property_get_id_of_get_value_function(),
+					the_property, 0, return_of_function, verbose))
 			{
 				buffer_release(return_of_function);
+				buffer_release(local_nodes);
 				return 0;
 			}
+		}
+		else
+		{
+			struct range name_space;
+			struct range name;
+			struct range arguments_area;
 
-			if (NULL != the_current_property &&
-				the_current_property == the_property)
+			if (!node.is_disassembled)
 			{
 				buffer_release(return_of_function);
+				buffer_release(local_nodes);
 				return 0;
 			}
 
-			if (!interpreter_actualize_property_value(
-					the_project, the_target, property_get_id_of_get_value_function(),
-					the_property, 0, return_of_function, verbose))
-			{
-				buffer_release(return_of_function);
-				return 0;
-			}
-		}
-		else
-		{
-			if (!interpreter_evaluate_function(the_project, the_target, &function, return_of_function, verbose))
+			name_space.start = code->start + node.name_space_start;
+			name_space.finish = code->start + node.name_space_finish;
+			name.start = code->start + node.name_start;
+			name.finish = code->start + node.name_finish;
+			arguments_area.start = code->start + node.arguments_area_start;
+			arguments_area.finish = code->start + node.arguments_area_finish;
+
+			if (!interpreter_evaluate_disassembled_function(
+					the_project, the_target, &name_space, &name, &arguments_area,
+					return_of_function, verbose))
 			{
 				buffer_release(return_of_function);
+				buffer_release(local_nodes);
 				return 0;
 			}
 		}
@@ -946,15 +1281,14 @@ uint8_t interpreter_evaluate_code(
 		if (!buffer_append_data_from_buffer(output, return_of_function))
 		{
 			buffer_release(return_of_function);
+			buffer_release(local_nodes);
 			return 0;
 		}
-
-		previous_pos = string_enumerate(function.finish, code->finish, NULL);
-		function.start = previous_pos;
 	}
 
 	buffer_release(return_of_function);
-	return buffer_append(output, previous_pos, range_size(code) - (previous_pos - code->start));
+	buffer_release(local_nodes);
+	return 1;
 }
 
 uint8_t interpreter_is_xml_tag_should_be_skip_by_if_or_unless(
@@ -1115,7 +1449,7 @@ uint8_t interpreter_get_arguments_from_xml_tag_record(
 	uint8_t attribute_value_buffer[BUFFER_SIZE_OF];
 	void* attribute_value = (void*)attribute_value_buffer;
 
-	if (!buffer_init(attribute_value, BUFFER_SIZE_OF))
+	if (!buffer_init_at_arena(attribute_value, BUFFER_SIZE_OF))
 	{
 		return 0;
 	}
@@ -1131,9 +1465,10 @@ uint8_t interpreter_get_arguments_from_xml_tag_record(
 			return 0;
 		}
 
-		if (!xml_get_attribute_value(start_of_attributes, finish_of_attributes,
-									 attributes[index], attributes_lengths[index],
-									 attribute_value))
+		if (!xml_get_attribute_value(
+				project_get_xml_index(the_project), start_of_attributes, finish_of_attributes,
+				attributes[index], attributes_lengths[index],
+				attribute_value))
 		{
 			continue;
 		}
@@ -1166,7 +1501,7 @@ uint8_t interpreter_get_xml_element_value(
 	uint8_t value_buffer[BUFFER_SIZE_OF];
 	void* value = (void*)value_buffer;
 
-	if (!buffer_init(value, BUFFER_SIZE_OF))
+	if (!buffer_init_at_arena(value, BUFFER_SIZE_OF))
 	{
 		return 0;
 	}
@@ -1196,6 +1531,7 @@ enum interpreter_task
 {
 	attrib_task,
 	call_task,
+	checksum_task,
 	choose_task,
 	copy_task,
 	delete_task,
@@ -1223,6 +1559,7 @@ enum interpreter_task
 	target_task,
 	touch_task,
 	trycatch_task,
+	wait_task,
 #if 0
 	tstamp_task,
 	uptodate_task,
@@ -1238,6 +1575,7 @@ uint8_t interpreter_get_task(const uint8_t* task_name_start, const uint8_t* task
 	{
 		(const uint8_t*)"attrib",
 		(const uint8_t*)"call",
+		(const uint8_t*)"checksum",
 		(const uint8_t*)"choose",
 		(const uint8_t*)"copy",
 		(const uint8_t*)"delete",
@@ -1265,6 +1603,7 @@ uint8_t interpreter_get_task(const uint8_t* task_name_start, const uint8_t* task
 		(const uint8_t*)"target",
 		(const uint8_t*)"touch",
 		(const uint8_t*)"trycatch",
+		(const uint8_t*)"wait",
 #if 0
 		(const uint8_t*)"tstamp",
 		(const uint8_t*)"uptodate",
@@ -1332,9 +1671,10 @@ uint8_t interpreter_prepare_attributes_and_arguments_for_property_task(
 		argument = buffer_buffer_data(task_arguments, dynamic);
 
 		if (!buffer_resize(argument, 0) ||
-			!xml_get_attribute_value(attributes_start, attributes_finish,
-									 (*task_attributes)[dynamic], (*task_attributes_lengths)[dynamic],
-									 argument))
+			!xml_get_attribute_value(
+					project_get_xml_index(the_project), attributes_start, attributes_finish,
+					(*task_attributes)[dynamic], (*task_attributes_lengths)[dynamic],
+					argument))
 		{
 			return 0;
 		}
@@ -1358,10 +1698,10 @@ uint8_t interpreter_evaluate_task(
 	const uint8_t* element_finish, const struct range* sub_nodes_names,
 	uint8_t target_help, uint8_t verbose)
 {
-	uint8_t task_arguments_buffer[BUFFER_SIZE_OF];
-	void* task_arguments = (void*)&task_arguments_buffer;
+	/*NOTE: arguments of the task taken from the pool, so the capacity of them is reused by the next tasks.*/
+	void* task_arguments = NULL;
 
-	if (!buffer_init(task_arguments, BUFFER_SIZE_OF))
+	if (!buffer_init_pool(&task_arguments))
 	{
 		return 0;
 	}
@@ -1373,7 +1713,7 @@ uint8_t interpreter_evaluate_task(
 		listener_task_started(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name,
 							  UNKNOWN_TASK, (const uint8_t*)the_module, verbose);
 		project_on_failure(the_project, the_target, task_arguments, verbose);
-		buffer_release(task_arguments);
+		buffer_return_to_pool(task_arguments);
 		listener_task_finished(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name,
 							   UNKNOWN_TASK, (const uint8_t*)the_module, 0, verbose);
 		/**/
@@ -1388,7 +1728,7 @@ uint8_t interpreter_evaluate_task(
 	if (range_in_parts_is_null_or_empty(attributes_start, element_finish))
 	{
 		project_on_failure(the_project, the_target, task_arguments, verbose);
-		buffer_release(task_arguments);
+		buffer_return_to_pool(task_arguments);
 		listener_task_finished(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name, task_id,
 							   (const uint8_t*)the_module, 0, verbose);
 		/**/
@@ -1399,7 +1739,8 @@ uint8_t interpreter_evaluate_task(
 	const uint8_t* task_attributes_lengths = NULL;
 	uint8_t task_attributes_count = 0;
 	/**/
-	const uint8_t* attributes_finish = xml_get_tag_finish_pos(attributes_start, element_finish);
+	const uint8_t* attributes_finish = xml_get_tag_finish_pos(
+			project_get_xml_index(the_project), attributes_start, element_finish);
 
 	if (target_task == task_id)
 	{
@@ -1409,7 +1750,7 @@ uint8_t interpreter_evaluate_task(
 		{
 			buffer_release_inner_buffers(task_arguments);
 			project_on_failure(the_project, the_target, task_arguments, verbose);
-			buffer_release(task_arguments);
+			buffer_return_to_pool(task_arguments);
 			listener_task_finished(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name, task_id,
 								   (const uint8_t*)the_module, 0, verbose);
 			/**/
@@ -1427,7 +1768,7 @@ uint8_t interpreter_evaluate_task(
 		{
 			buffer_release_inner_buffers(task_arguments);
 			project_on_failure(the_project, the_target, task_arguments, verbose);
-			buffer_release(task_arguments);
+			buffer_return_to_pool(task_arguments);
 			listener_task_finished(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name, task_id,
 								   (const uint8_t*)the_module, 0, verbose);
 			/**/
@@ -1440,13 +1781,14 @@ uint8_t interpreter_evaluate_task(
 
 		if (task_attributes_count)
 		{
-			buffer_release_with_inner_buffers(task_arguments);
+			buffer_release_inner_buffers(task_arguments);
+			buffer_return_to_pool(task_arguments);
 		}
 		else
 		{
 			buffer_release_inner_buffers(task_arguments);
 			project_on_failure(the_project, the_target, task_arguments, verbose);
-			buffer_release(task_arguments);
+			buffer_return_to_pool(task_arguments);
 		}
 
 		listener_task_finished(
@@ -1461,7 +1803,7 @@ uint8_t interpreter_evaluate_task(
 	{
 		buffer_release_inner_buffers(task_arguments);
 		project_on_failure(the_project, the_target, task_arguments, verbose);
-		buffer_release(task_arguments);
+		buffer_return_to_pool(task_arguments);
 		listener_task_finished(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name, task_id,
 							   (const uint8_t*)the_module, 0, verbose);
 		/**/
@@ -1470,7 +1812,8 @@ uint8_t interpreter_evaluate_task(
 
 	if (task_attributes_count)
 	{
-		buffer_release_with_inner_buffers(task_arguments);
+		buffer_release_inner_buffers(task_arguments);
+		buffer_return_to_pool(task_arguments);
 		listener_task_finished(
 			NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name, task_id, NULL,
 			task_attributes_count, verbose);
@@ -1487,7 +1830,7 @@ uint8_t interpreter_evaluate_task(
 	{
 		buffer_release_inner_buffers(task_arguments);
 		project_on_failure(the_project, the_target, task_arguments, verbose);
-		buffer_release(task_arguments);
+		buffer_return_to_pool(task_arguments);
 		listener_task_finished(NULL, 0, (const uint8_t*)the_project, (const uint8_t*)the_target, task_name, task_id,
 							   (const uint8_t*)the_module, 0, verbose);
 		/**/
@@ -1511,13 +1854,14 @@ uint8_t interpreter_evaluate_task(
 
 			if (task_attributes_count)
 			{
-				buffer_release_with_inner_buffers(task_arguments);
+				buffer_release_inner_buffers(task_arguments);
+				buffer_return_to_pool(task_arguments);
 			}
 			else
 			{
 				buffer_release_inner_buffers(task_arguments);
 				project_on_failure(the_project, the_target, task_arguments, verbose);
-				buffer_release(task_arguments);
+				buffer_return_to_pool(task_arguments);
 			}
 
 			listener_task_finished(
@@ -1569,6 +1913,25 @@ uint8_t interpreter_evaluate_task(
 			task_attributes_count = call_evaluate_task(the_project, task_arguments, verbose);
 			break;
 
+		case checksum_task:
+			if (!checksum_get_attributes_and_arguments_for_task(&task_attributes, &task_attributes_lengths,
+					&task_attributes_count, task_arguments))
+			{
+				task_attributes_count = 0;
+				break;
+			}
+
+			if (!interpreter_get_arguments_from_xml_tag_record(
+					the_project, the_target, attributes_start, attributes_finish,
+					task_attributes, task_attributes_lengths, 0, task_attributes_count, task_arguments, verbose))
+			{
+				task_attributes_count = 0;
+				break;
+			}
+
+			task_attributes_count = checksum_evaluate_task(the_project, the_target, task_arguments, verbose);
+			break;
+
 		case choose_task:
 			task_attributes_count = choose_evaluate_task(the_project, the_target, attributes_finish, element_finish,
 									task_arguments, verbose);
@@ -1624,7 +1987,7 @@ uint8_t interpreter_evaluate_task(
 
 				task_attributes_count =
 					echo(0, UTF8, NULL, Info, buffer_uint8_t_data(task_arguments, 0), buffer_size(task_arguments), 1, verbose);
-				buffer_release(task_arguments);
+				buffer_return_to_pool(task_arguments);
 			}
 			else
 			{
@@ -1946,6 +2309,25 @@ uint8_t interpreter_evaluate_task(
 										the_project, the_target, attributes_finish, element_finish,
 										task_arguments, verbose);
 			break;
+
+		case wait_task:
+			if (!wait_get_attributes_and_arguments_for_task(&task_attributes, &task_attributes_lengths,
+					&task_attributes_count, task_arguments))
+			{
+				task_attributes_count = 0;
+				break;
+			}
+
+			if (!interpreter_get_arguments_from_xml_tag_record(
+					the_project, the_target, attributes_start, attributes_finish,
+					task_attributes, task_attributes_lengths, 0, task_attributes_count, task_arguments, verbose))
+			{
+				task_attributes_count = 0;
+				break;
+			}
+
+			task_attributes_count = wait_evaluate_task(the_project, task_arguments, verbose);
+			break;
 #if 0
 
 		case tstamp_:
@@ -1986,13 +2368,14 @@ uint8_t interpreter_evaluate_task(
 
 	if (task_attributes_count)
 	{
-		buffer_release_with_inner_buffers(task_arguments);
+		buffer_release_inner_buffers(task_arguments);
+		buffer_return_to_pool(task_arguments);
 	}
 	else
 	{
 		buffer_release_inner_buffers(task_arguments);
 		project_on_failure(the_project, the_target, task_arguments, verbose);
-		buffer_release(task_arguments);
+		buffer_return_to_pool(task_arguments);
 	}
 
 	listener_task_finished(
@@ -2015,10 +2398,12 @@ uint8_t interpreter_evaluate_tasks(
 		struct range tag_name;
 		tag_name.start = element->start;
 		tag_name.finish = xml_get_tag_name(element->start, element->finish);
-		/**/
+		/*NOTE: temporaries of the task are released together when it finished.*/
+		const ptrdiff_t arena_position = buffer_arena_begin();
 		returned = interpreter_evaluate_task(
 					   the_project, the_target, &tag_name, element->finish,
 					   sub_nodes_names, target_help, verbose);
+		buffer_arena_end(arena_position);
 
 		if (!returned)
 		{
@@ -10,8 +10,8 @@
 #include "buffer.h"
 #include "common.h"
 #include "conversion.h"
-#include "date_time.h"
 #include "exec.h"
+#include "file_system.h"
 #include "interpreter.h"
 #include "project.h"
 #include "range.h"
@@ -96,7 +96,7 @@ uint8_t interpreter_get_environments(
 	}
 
 	uint16_t elements_count = xml_get_sub_nodes_elements(
-								  attributes_finish, element_finish, NULL, elements);
+								  project_get_xml_index(the_project), attributes_finish, element_finish, NULL, elements);
 
 	if (!elements_count)
 	{
@@ -140,7 +140,7 @@ uint8_t interpreter_get_environments(
 		}
 
 		uint16_t sub_elements_count = xml_get_sub_nodes_elements(
-										  env_ptr->start, env_ptr->finish, NULL, sub_elements);
+										  project_get_xml_index(the_project), env_ptr->start, env_ptr->finish, NULL, sub_elements);
 
 		if (!sub_elements_count)
 		{
@@ -294,12 +294,15 @@ static const uint8_t* exec_attributes[] =
 	(const uint8_t*)"resultproperty",
 	(const uint8_t*)"spawn",
 	(const uint8_t*)"workingdir",
-	(const uint8_t*)"timeout"
+	(const uint8_t*)"timeout",
+	(const uint8_t*)"outputproperty",
+	(const uint8_t*)"erroroutput",
+	(const uint8_t*)"erroroutputproperty"
 };
 
 static const uint8_t exec_attributes_lengths[] =
 {
-	7, 6, 7, 11, 6, 11, 14, 5, 10, 7
+	7, 6, 7, 11, 6, 11, 14, 5, 10, 7, 14, 11, 19
 };
 
 #define PROGRAM_POSITION			0
@@ -312,7 +315,10 @@ static const uint8_t exec_attributes_lengths[] =
 #define SPAWN_POSITION				7
 #define WORKING_DIR_POSITION		8
 #define TIME_OUT_POSITION			9
-#define ENVIRONMENT_POSITION		10
+#define OUTPUT_PROPERTY_POSITION	10
+#define ERROR_OUTPUT_POSITION		11
+#define ERROR_PROPERTY_POSITION		12
+#define ENVIRONMENT_POSITION		13
 
 #define ATTRIBUTES_COUNT	(ENVIRONMENT_POSITION + 1)
 
@@ -383,64 +389,57 @@ uint8_t exec_evaluate_task(
 	struct range command_line;
 	BUFFER_TO_RANGE(command_line, command_line_in_a_buffer);
 	/**/
-	void* output_path_in_a_buffer = buffer_buffer_data(task_arguments, OUTPUT_POSITION);
-	struct range output_file;
-	ptrdiff_t size = buffer_size(output_path_in_a_buffer);
+	struct range output_files[2];
+	static const uint8_t output_positions[] = { OUTPUT_POSITION, ERROR_OUTPUT_POSITION };
+	ptrdiff_t size;
 
-	if (size)
-	{
-		if (!buffer_push_back(output_path_in_a_buffer, 0))
-		{
-			return 0;
-		}
-
-		++size;
-		output_file.start = buffer_uint8_t_data(output_path_in_a_buffer, 0);
-		output_file.finish = output_file.start + size;
-	}
-	else
+	for (uint8_t i = 0; i < COUNT_OF(output_positions); ++i)
 	{
-		output_file.start = output_file.finish = NULL;
-	}
+		void* output_path_in_a_buffer = buffer_buffer_data(task_arguments, output_positions[i]);
+		size = buffer_size(output_path_in_a_buffer);
 
-	void* pid_property = NULL;
-	void* result_property = NULL;
-
-	for (uint8_t index = PID_PROPERTY_POSITION; ; index = RESULT_PROPERTY_POSITION)
-	{
-		const void* property_in_a_buffer = buffer_buffer_data(task_arguments, index);
-		size = buffer_size(property_in_a_buffer);
-
-		if (!size)
+		if (size)
 		{
-			if (RESULT_PROPERTY_POSITION == index)
+			if (!buffer_push_back(output_path_in_a_buffer, 0))
 			{
-				break;
+				return 0;
 			}
 
-			continue;
+			++size;
+			output_files[i].start = buffer_uint8_t_data(output_path_in_a_buffer, 0);
+			output_files[i].finish = output_files[i].start + size;
 		}
-
-		if (NULL == the_project)
+		else
 		{
-			return 0;
+			output_files[i].start = output_files[i].finish = NULL;
 		}
+	}
+
+	struct range properties[4];
+	static const uint8_t property_positions[] =
+	{
+		PID_PROPERTY_POSITION, RESULT_PROPERTY_POSITION,
+		OUTPUT_PROPERTY_POSITION, ERROR_PROPERTY_POSITION
+	};
 
-		void** the_property = (PID_PROPERTY_POSITION == index ? &pid_property : &result_property);
-		value = buffer_uint8_t_data(property_in_a_buffer, 0);
+	for (uint8_t i = 0; i < COUNT_OF(property_positions); ++i)
+	{
+		const void* property_in_a_buffer = buffer_buffer_data(task_arguments, property_positions[i]);
+		BUFFER_TO_RANGE(properties[i], property_in_a_buffer);
 
-		if (!project_property_set_value(the_project, value,
-										(uint8_t)size, (const uint8_t*)the_property,
-										0, 0, 1, 0, verbose) ||
-			!project_property_exists(the_project, value,
-									 (uint8_t)size, the_property, verbose))
+		if (range_is_null_or_empty(&(properties[i])))
 		{
-			return 0;
+			continue;
 		}
 
-		if (RESULT_PROPERTY_POSITION == index)
+		/*NOTE: property created here, but set by name,
+		  because interpreter can be left while program is waited.*/
+		if (NULL == the_project ||
+			!project_property_set_value(the_project, properties[i].start,
+										(uint8_t)range_size(&(properties[i])), properties[i].start,
+										0, 0, 1, 0, verbose))
 		{
-			break;
+			return 0;
 		}
 	}
 
@@ -481,16 +480,7 @@ uint8_t exec_evaluate_task(
 	{
 		value = buffer_uint8_t_data(time_out_in_a_buffer, 0);
 		time_out = uint64_parse(value, value + size);
-
-		if (1000 < time_out)
-		{
-			time_out = (uint64_t)date_time_millisecond_to_second(time_out);
-
-			if (time_out < 5)
-			{
-				time_out = 5;
-			}
-		}
+		time_out = MIN(time_out, UINT32_MAX);
 	}
 
 	const void* environment_in_a_buffer = buffer_buffer_data(task_arguments, ENVIRONMENT_POSITION);
@@ -507,8 +497,106 @@ uint8_t exec_evaluate_task(
 		environment_variables.start = environment_variables.finish = NULL;
 	}
 
-	return exec(the_project, the_target,
-				append, path_to_the_program, &base_directory, &command_line, &output_file,
-				pid_property, result_property, &working_directory, &environment_variables,
-				spawn, (uint32_t)time_out, verbose);
+	const uint8_t result = exec(the_project, the_target,
+								append, path_to_the_program, &base_directory, &command_line,
+								&(output_files[0]), &(properties[2]), &(output_files[1]), &(properties[3]),
+								&(properties[0]), &(properties[1]), &working_directory, &environment_variables,
+								spawn, (uint32_t)time_out, verbose);
+	/*NOTE: program can change any entry of the file system.*/
+	file_system_stat_cache_invalidate(NULL, 0);
+	/**/
+	return result;
+}
+
+#define WAIT_PID_POSITION				0
+#define WAIT_RESULT_PROPERTY_POSITION	1
+#define WAIT_TIME_OUT_POSITION			2
+
+uint8_t wait_get_attributes_and_arguments_for_task(
+	const uint8_t*** task_attributes, const uint8_t** task_attributes_lengths,
+	uint8_t* task_attributes_count, void* task_arguments)
+{
+	static const uint8_t* wait_attributes[] =
+	{
+		(const uint8_t*)"pid",
+		(const uint8_t*)"resultproperty",
+		(const uint8_t*)"timeout"
+	};
+	/**/
+	static const uint8_t wait_attributes_lengths[] = { 3, 14, 7 };
+	/**/
+	return common_get_attributes_and_arguments_for_task(
+			   wait_attributes, wait_attributes_lengths,
+			   COUNT_OF(wait_attributes),
+			   task_attributes, task_attributes_lengths,
+			   task_attributes_count, task_arguments);
+}
+
+uint8_t wait_evaluate_task(
+	void* the_project, const void* task_arguments, uint8_t verbose)
+{
+	static const uint8_t delimiters[] = { ' ', '\t', '\r', '\n', ';', ',' };
+	/**/
+	const void* pid_in_a_buffer = buffer_buffer_data(task_arguments, WAIT_PID_POSITION);
+	const uint8_t* start = buffer_uint8_t_data(pid_in_a_buffer, 0);
+	const uint8_t* finish = start + buffer_size(pid_in_a_buffer);
+	/**/
+	uint8_t pids_buffer[BUFFER_SIZE_OF];
+	void* pids = (void*)pids_buffer;
+
+	if (!buffer_init(pids, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	while (finish != (start = string_find_any_symbol_like_or_not_like_that(
+								  start, finish, delimiters, delimiters + COUNT_OF(delimiters), 0, 1)))
+	{
+		const uint8_t* pos = string_find_any_symbol_like_or_not_like_that(
+								 start, finish, delimiters, delimiters + COUNT_OF(delimiters), 1, 1);
+		const int64_t pid = int64_parse(start, pos);
+
+		if (pid < 1 ||
+			!buffer_append(pids, (const uint8_t*)&pid, sizeof(int64_t)))
+		{
+			buffer_release(pids);
+			return 0;
+		}
+
+		start = pos;
+	}
+
+	const void* property_in_a_buffer = buffer_buffer_data(task_arguments, WAIT_RESULT_PROPERTY_POSITION);
+	struct range result_property;
+	BUFFER_TO_RANGE(result_property, property_in_a_buffer);
+	ptrdiff_t size = range_size(&result_property);
+
+	if (size)
+	{
+		if (NULL == the_project ||
+			!project_property_set_value(the_project, result_property.start,
+										(uint8_t)size, result_property.start,
+										0, 0, 1, 0, verbose))
+		{
+			buffer_release(pids);
+			return 0;
+		}
+	}
+
+	const void* time_out_in_a_buffer = buffer_buffer_data(task_arguments, WAIT_TIME_OUT_POSITION);
+	uint64_t time_out = 0;
+	size = buffer_size(time_out_in_a_buffer);
+
+	if (size)
+	{
+		start = buffer_uint8_t_data(time_out_in_a_buffer, 0);
+		time_out = uint64_parse(start, start + size);
+		time_out = MIN(time_out, UINT32_MAX);
+	}
+
+	const uint8_t result = exec_wait(the_project, pids, (uint32_t)time_out, &result_property, verbose);
+	buffer_release(pids);
+	file_system_stat_cache_invalidate(NULL, 0);
+	/**/
+	return result;
 }
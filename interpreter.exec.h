@@ -24,4 +24,10 @@ uint8_t exec_get_attributes_and_arguments_for_task(
 uint8_t exec_evaluate_task(
 	void* the_project, const void* the_target, const void* task_arguments, uint8_t verbose);
 
+uint8_t wait_get_attributes_and_arguments_for_task(
+	const uint8_t*** task_attributes, const uint8_t** task_attributes_lengths,
+	uint8_t* task_attributes_count, void* task_arguments);
+uint8_t wait_evaluate_task(
+	void* the_project, const void* task_arguments, uint8_t verbose);
+
 #endif
@@ -11,10 +11,12 @@
 #include "common.h"
 #include "conversion.h"
 #include "date_time.h"
+#include "echo.h"
 #include "hash.h"
 #include "interpreter.h"
 #include "path.h"
 #include "range.h"
+#include "text_encoding.h"
 
 enum file_function
 {
@@ -187,7 +189,7 @@ uint8_t dir_exec_function(uint8_t function, const void* arguments, uint8_t argum
 			}
 
 			return directory_enumerate_file_system_entries(
-					   buffer_buffer_data(arguments, 0), entry_type, recurse, output, 1);
+					   buffer_buffer_data(arguments, 0), entry_type, recurse, NULL, output, 1, 1);
 		}
 
 		case dir_exists:
@@ -252,9 +254,46 @@ uint8_t file_get_function(const uint8_t* name_start, const uint8_t* name_finish)
 	return common_string_to_enum(name_start, name_finish, file_function_str, UNKNOWN_FILE_FUNCTION);
 }
 
+uint8_t file_replace_with_arguments(const void* arguments, uint8_t arguments_count, void* output)
+{
+	if (NULL == arguments ||
+		arguments_count < 3 ||
+		0 == arguments_count % 2)
+	{
+		return 0;
+	}
+
+	uint8_t values_buffer[BUFFER_SIZE_OF];
+	void* values = (void*)values_buffer;
+
+	if (!buffer_init(values, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	if (!buffer_append(values, NULL, arguments_count * sizeof(struct range)) ||
+		!common_get_arguments(arguments, arguments_count, buffer_range_data(values, 0), 1))
+	{
+		buffer_release(values);
+		return 0;
+	}
+
+	const struct range* path = buffer_range_data(values, 0);
+	const uint8_t returned = file_replace_in_pairs(path->start, path + 1, (arguments_count - 1) / 2);
+	buffer_release(values);
+	/**/
+	return bool_to_string(returned, output);
+}
+
 uint8_t file_exec_function(uint8_t function, const void* arguments, uint8_t arguments_count,
 						   void* output)
 {
+	if (file_replace_ == function &&
+		NULL != output)
+	{
+		return file_replace_with_arguments(arguments, arguments_count, output);
+	}
+
 	if (UNKNOWN_FILE_FUNCTION <= function ||
 		NULL == arguments ||
 		!arguments_count ||
@@ -318,13 +357,6 @@ uint8_t file_exec_function(uint8_t function, const void* arguments, uint8_t argu
 			return 2 == arguments_count &&
 				   bool_to_string(file_up_to_date(values[0].start, values[1].start), output);
 
-		case file_replace_:
-			return 3 == arguments_count &&
-				   bool_to_string(
-					   file_replace(values[0].start,
-									values[1].start, values[1].finish,
-									values[2].start, values[2].finish), output);
-
 		case UNKNOWN_FILE_FUNCTION:
 		default:
 			break;
@@ -428,14 +460,16 @@ uint8_t attrib_evaluate_task(void* task_arguments, uint8_t verbose)
 
 #define DELETE_DIR_POSITION		0
 #define DELETE_FILE_POSITION	1
+#define DELETE_THREADS_POSITION	2
 
 static const uint8_t* delete_attributes[] =
 {
 	(const uint8_t*)"dir",
-	(const uint8_t*)"file"
+	(const uint8_t*)"file",
+	(const uint8_t*)"threads"
 };
 
-static const uint8_t delete_attributes_lengths[] = { 3, 4 };
+static const uint8_t delete_attributes_lengths[] = { 3, 4, 7 };
 
 uint8_t delete_get_attributes_and_arguments_for_task(
 	const uint8_t*** task_attributes, const uint8_t** task_attributes_lengths,
@@ -448,6 +482,33 @@ uint8_t delete_get_attributes_and_arguments_for_task(
 			   task_attributes_count, task_arguments);
 }
 
+uint8_t delete_report_failures(const void* failures, void* output)
+{
+	static const uint8_t* failed = (const uint8_t*)"Failed to delete '";
+	static const uint8_t* end = (const uint8_t*)"'.";
+	/**/
+	const uint8_t* start = buffer_uint8_t_data(failures, 0);
+	const uint8_t* finish = start + buffer_size(failures);
+
+	while (start < finish)
+	{
+		const ptrdiff_t length = common_count_bytes_until(start, 0);
+
+		if (!buffer_resize(output, 0) ||
+			!buffer_append(output, failed, 18) ||
+			!buffer_append(output, start, length) ||
+			!buffer_append(output, end, 2) ||
+			!echo(0, Default, NULL, Warning, buffer_uint8_t_data(output, 0), buffer_size(output), 1, 0))
+		{
+			return 0;
+		}
+
+		start += length + 1;
+	}
+
+	return 1;
+}
+
 uint8_t delete_evaluate_task(void* task_arguments, uint8_t verbose)
 {
 	if (NULL == task_arguments)
@@ -507,7 +568,28 @@ uint8_t delete_evaluate_task(void* task_arguments, uint8_t verbose)
 
 	if (dir_ && directory_exists(dir_))
 	{
-		verbose = directory_delete(dir_) && verbose;
+		void* threads_in_a_buffer = buffer_buffer_data(task_arguments, DELETE_THREADS_POSITION);
+		uint16_t threads = (uint16_t)buffer_size(threads_in_a_buffer);
+
+		if (threads)
+		{
+			const uint8_t* value = buffer_uint8_t_data(threads_in_a_buffer, 0);
+			const uint64_t count = uint64_parse(value, value + threads);
+			threads = (uint16_t)MIN(count, UINT16_MAX);
+		}
+
+		/*NOTE: the buffer of the attribute is reused to collect entries that were not deleted.*/
+		if (!buffer_resize(threads_in_a_buffer, 0))
+		{
+			return 0;
+		}
+
+		verbose = directory_delete_with_threads(dir_, threads, threads_in_a_buffer) && verbose;
+
+		if (!delete_report_failures(threads_in_a_buffer, file_path_in_buffer))
+		{
+			return 0;
+		}
 	}
 
 	return verbose;
@@ -69,6 +69,12 @@ uint8_t file_get_checksum(
 	const uint8_t* path, const struct range* algorithm,
 	const struct range* algorithm_parameter, void* output);
 
+uint8_t checksum_get_attributes_and_arguments_for_task(
+	const uint8_t*** task_attributes, const uint8_t** task_attributes_lengths,
+	uint8_t* task_attributes_count, void* task_arguments);
+uint8_t checksum_evaluate_task(
+	void* the_project, const void* the_target, void* task_arguments, uint8_t verbose);
+
 /*math_unit*/
 uint8_t math_get_function(const uint8_t* name_start, const uint8_t* name_finish);
 uint8_t math_exec_function(uint8_t function, const void* arguments,
@@ -146,6 +152,10 @@ uint8_t interpreter_get_values_for_arguments(
 uint8_t interpreter_evaluate_function(
 	const void* the_project, const void* the_target,
 	const struct range* function, void* output, uint8_t verbose);
+uint8_t interpreter_evaluate_disassembled_function(
+	const void* the_project, const void* the_target,
+	const struct range* name_space, const struct range* name,
+	const struct range* arguments_area, void* output, uint8_t verbose);
 uint8_t interpreter_evaluate_code(
 	const void* the_project, const void* the_target,
 	const void* the_current_property, const struct range* code,
@@ -11,9 +11,17 @@
 #include "buffer.h"
 #include "common.h"
 #include "conversion.h"
+#include "echo.h"
 #include "file_system.h"
+#include "interpreter.file_system.h"
+#include "path.h"
+#include "project.h"
 #include "range.h"
+#include "string_unit.h"
+#include "text_encoding.h"
+#include "thread.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 static const uint8_t* crc32_parameters_str[] =
@@ -37,6 +45,10 @@ static const uint8_t* hash_function_str[] =
 	(const uint8_t*)"crc32",
 	(const uint8_t*)"keccak",
 	(const uint8_t*)"sha3",
+	(const uint8_t*)"shake128",
+	(const uint8_t*)"shake256",
+	(const uint8_t*)"xxh128",
+	(const uint8_t*)"xxh3",
 	(const uint8_t*)"xxh32",
 	(const uint8_t*)"xxh64"
 };
@@ -47,6 +59,8 @@ enum hash_function
 	bytes_to_string,
 	crc32,
 	keccak, sha3,
+	shake128, shake256,
+	xxh128, xxh3,
 	xxh32, xxh64,
 	UNKNOWN_HASH_FUNCTION
 };
@@ -74,7 +88,7 @@ uint8_t hash_algorithm_exec_function(uint8_t function, const void* arguments,
 		return 0;
 	}
 
-	uint16_t hash_length = 256;
+	uint16_t hash_length = shake256 == function ? 512 : 256;
 
 	if (2 == arguments_count &&
 		crc32 != function &&
@@ -129,6 +143,33 @@ uint8_t hash_algorithm_exec_function(uint8_t function, const void* arguments,
 		case sha3:
 			return hash_algorithm_sha3(values[0].start, values[0].finish, hash_length, output);
 
+		case shake128:
+			return hash_algorithm_shake(values[0].start, values[0].finish, 128, hash_length, output);
+
+		case shake256:
+			return hash_algorithm_shake(values[0].start, values[0].finish, 256, hash_length, output);
+
+		case xxh128:
+		case xxh3:
+		{
+			const uint8_t is_128 = xxh128 == function;
+
+			if (!buffer_append(output, NULL, (1 + is_128) * sizeof(uint64_t)))
+			{
+				return 0;
+			}
+
+			uint64_t seed = 0;
+
+			if (2 == arguments_count)
+			{
+				seed = uint64_parse(values[1].start, values[1].finish);
+			}
+
+			uint64_t* ptr = (uint64_t*)buffer_data(output, buffer_size(output) - (1 + is_128) * sizeof(uint64_t));
+			return hash_algorithm_XXH3(values[0].start, values[0].finish, seed, is_128, ptr);
+		}
+
 		case xxh32:
 		{
 			if (!buffer_push_back_uint32_t(output, 0))
@@ -184,7 +225,7 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 		return 0;
 	}
 
-	uint16_t hash_length = crc32 == algorithm ? 1 : 256;
+	uint16_t hash_length = crc32 == algorithm ? 1 : (shake256 == algorithm ? 512 : 256);
 
 	if (!range_is_null_or_empty(algorithm_parameter))
 	{
@@ -199,13 +240,16 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 				return 0;
 			}
 		}
-		else if (xxh32 != algorithm &&
+		else if (xxh128 != algorithm &&
+				 xxh3 != algorithm &&
+				 xxh32 != algorithm &&
 				 xxh64 != algorithm)
 		{
 			hash_length = (uint16_t)int_parse(
 							  algorithm_parameter->start, algorithm_parameter->finish);
 
-			if (hash_length < 8 || 1024 < hash_length)
+			if (hash_length < 8 || 1024 < hash_length ||
+				((shake128 == algorithm || shake256 == algorithm) && 0 != hash_length % 8))
 			{
 				return 0;
 			}
@@ -241,7 +285,7 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 
 			size_t readed = 0;
 			uint8_t* last = NULL;
-			ptrdiff_t bytes_compressed = 0;
+			uint64_t bytes_compressed = 0;
 			uint8_t* file_content = buffer_uint8_t_data(output, size + 64 + 128);
 
 			while (0 < (readed = file_read(file_content, sizeof(uint8_t), 4096, file)))
@@ -271,7 +315,7 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 							return 0;
 						}
 
-						readed -= bytes_compressed;
+						readed -= bytes_to_compress;
 						file_content += bytes_to_compress;
 					}
 
@@ -329,16 +373,18 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 			static const uint8_t d = 0;
 			static const uint8_t h_size = 8 * sizeof(uint32_t);
 			static const uint8_t m_size = 16 * sizeof(uint32_t);
+			/*NOTE: large reads let the chunks be compressed side by side and by several threads.*/
+			static const ptrdiff_t read_length = (ptrdiff_t)1 << 20;
 
 			if (!buffer_append(output, NULL,
-							   (ptrdiff_t)4096 + h_size + m_size + 1900))
+							   read_length + h_size + m_size + 1900))
 			{
 				break;
 			}
 
-			uint32_t* h = (uint32_t*)buffer_data(output, size + 4096);
-			uint32_t* m = (uint32_t*)buffer_data(output, size + 4096 + h_size);
-			uint8_t* stack = buffer_uint8_t_data(output, size + 4096 + h_size + m_size);
+			uint32_t* h = (uint32_t*)buffer_data(output, size + read_length);
+			uint32_t* m = (uint32_t*)buffer_data(output, size + read_length + h_size);
+			uint8_t* stack = buffer_uint8_t_data(output, size + read_length + h_size + m_size);
 
 			if (!BLAKE3_init(h, 8, m, 16, 1900))
 			{
@@ -355,9 +401,10 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 			/**/
 			uint8_t* file_content = buffer_uint8_t_data(output, size);
 
-			while (0 < (readed = file_read(file_content, sizeof(uint8_t), 4096, file)))
+			while (0 < (readed = file_read(file_content, sizeof(uint8_t), read_length, file)))
 			{
-				if (!BLAKE3_core(file_content, readed, m, &l, h, &compressed, t, stack, &stack_length, d))
+				if (!BLAKE3_core(file_content, readed, m, &l, h, &compressed, t, stack, &stack_length, d,
+								 common_get_jobs()))
 				{
 					file_close(file);
 					return 0;
@@ -379,21 +426,24 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 
 		case crc32:
 		{
-			if (!buffer_append(output, NULL, 4096 + sizeof(uint32_t)))
+			/*NOTE: folding engine is faster than the small reads, so file is read by the larger blocks.*/
+			static const ptrdiff_t read_length = (ptrdiff_t)1 << 16;
+
+			if (!buffer_append(output, NULL, read_length + sizeof(uint32_t)))
 			{
 				break;
 			}
 
 			size_t readed = 0;
 			uint8_t* file_content = buffer_uint8_t_data(output, size);
-			uint8_t* out = file_content + 4096;
+			uint8_t* out = file_content + read_length;
 
 			if (!hash_algorithm_crc32_init(out))
 			{
 				break;
 			}
 
-			while (0 < (readed = file_read(file_content, sizeof(uint8_t), 4096, file)))
+			while (0 < (readed = file_read(file_content, sizeof(uint8_t), read_length, file)))
 			{
 				if (!hash_algorithm_crc32_core(file_content, file_content + readed, out))
 				{
@@ -414,17 +464,28 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 
 		case keccak:
 		case sha3:
+		case shake128:
+		case shake256:
 		{
+			static const ptrdiff_t read_length = (ptrdiff_t)1 << 16;
 			uint8_t rate_on_w;
 			uint8_t maximum_delta;
 
-			if (!hash_algorithm_sha3_init(
-					hash_length, &rate_on_w, &maximum_delta))
+			if (shake128 == algorithm || shake256 == algorithm)
+			{
+				if (!hash_algorithm_shake_init(
+						shake128 == algorithm ? 128 : 256, &rate_on_w, &maximum_delta))
+				{
+					break;
+				}
+			}
+			else if (!hash_algorithm_sha3_init(
+						 hash_length, &rate_on_w, &maximum_delta))
 			{
 				break;
 			}
 
-			if (!buffer_append(output, NULL, 4096))
+			if (!buffer_append(output, NULL, read_length))
 			{
 				break;
 			}
@@ -443,7 +504,7 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 			size_t readed = 0;
 			uint8_t* file_content = buffer_uint8_t_data(output, size);
 
-			while (0 < (readed = file_read(file_content, sizeof(uint8_t), 4096, file)))
+			while (0 < (readed = file_read(file_content, sizeof(uint8_t), read_length, file)))
 			{
 				const uint8_t* finish = file_content + readed;
 				readed = hash_algorithm_sha3_core(file_content, finish, queue, &queue_size, maximum_delta, S, rate_on_w);
@@ -456,12 +517,17 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 			}
 
 			hash_length /= 8;
-			file_content += 64;
+			/*NOTE: hex string is written at the start of buffer, so up to 128 bytes of the output should be placed out of it.*/
+			file_content += 256;
 
 			if (!file_close(file) ||
-				!hash_algorithm_sha3_final(
-					sha3 == algorithm, queue, queue_size, maximum_delta, S, rate_on_w,
-					(uint8_t)hash_length, file_content))
+				!((shake128 == algorithm || shake256 == algorithm) ?
+				  hash_algorithm_shake_final(
+					  queue, queue_size, maximum_delta, S, rate_on_w,
+					  hash_length, file_content) :
+				  hash_algorithm_sha3_final(
+					  sha3 == algorithm, queue, queue_size, maximum_delta, S, rate_on_w,
+					  (uint8_t)hash_length, file_content)))
 			{
 				break;
 			}
@@ -470,6 +536,61 @@ uint8_t file_get_checksum_(const uint8_t* path, uint8_t algorithm,
 				   hash_algorithm_bytes_to_string(file_content, file_content + hash_length, output);
 		}
 
+		case xxh128:
+		case xxh3:
+		{
+			static const ptrdiff_t read_length = (ptrdiff_t)1 << 16;
+
+			if (!buffer_append(output, NULL, read_length))
+			{
+				break;
+			}
+
+			uint8_t queue[256];
+			uint16_t queue_size = 0;
+			uint64_t accumulators[10];
+			uint8_t secret[192];
+			uint64_t out[2];
+			/**/
+			uint64_t seed = 0;
+
+			if (!range_is_null_or_empty(algorithm_parameter))
+			{
+				seed = uint64_parse(algorithm_parameter->start, algorithm_parameter->finish);
+			}
+
+			if (!hash_algorithm_XXH3_init(seed, accumulators, secret))
+			{
+				break;
+			}
+
+			size_t readed = 0;
+			uint8_t* file_content = buffer_uint8_t_data(output, size);
+
+			while (0 < (readed = file_read(file_content, sizeof(uint8_t), read_length, file)))
+			{
+				if (!hash_algorithm_XXH3_core(file_content, file_content + readed,
+											  queue, &queue_size, accumulators, secret))
+				{
+					file_close(file);
+					return 0;
+				}
+			}
+
+			if (!file_close(file) ||
+				!(xxh128 == algorithm ?
+				  hash_algorithm_XXH3_128_final(queue, queue_size, accumulators, secret, seed, out) :
+				  hash_algorithm_XXH3_64_final(queue, queue_size, accumulators, secret, seed, out)))
+			{
+				return 0;
+			}
+
+			file_content = (uint8_t*)out;
+			return buffer_resize(output, size) &&
+				   hash_algorithm_bytes_to_string(
+					   file_content, file_content + (1 + (xxh128 == algorithm)) * sizeof(uint64_t), output);
+		}
+
 		case xxh32:
 		{
 			if (!buffer_append(output, NULL, 4096))
@@ -588,3 +709,779 @@ uint8_t file_get_checksum(const uint8_t* path, const struct range* algorithm,
 							  hash_function_str, UNKNOWN_HASH_FUNCTION),
 							  algorithm_parameter, output);
 }
+
+#define CHECKSUM_ALGORITHM_POSITION				0
+#define CHECKSUM_ALGORITHM_PARAMETER_POSITION	1
+#define CHECKSUM_DIR_POSITION					2
+#define CHECKSUM_INCLUDE_POSITION				3
+#define CHECKSUM_EXCLUDE_POSITION				4
+#define CHECKSUM_MANIFEST_POSITION				5
+#define CHECKSUM_VERIFY_POSITION				6
+#define CHECKSUM_THREADS_POSITION				7
+#define CHECKSUM_RESULT_PROPERTY_POSITION		8
+#define CHECKSUM_MISMATCH_PROPERTY_POSITION		9
+
+#define CHECKSUM_MAX_HASH_LENGTH				256
+
+static const uint8_t* checksum_attributes[] =
+{
+	(const uint8_t*)"algorithm",
+	(const uint8_t*)"algorithmparameter",
+	(const uint8_t*)"dir",
+	(const uint8_t*)"include",
+	(const uint8_t*)"exclude",
+	(const uint8_t*)"manifest",
+	(const uint8_t*)"verify",
+	(const uint8_t*)"threads",
+	(const uint8_t*)"resultproperty",
+	(const uint8_t*)"mismatchproperty"
+};
+
+static const uint8_t checksum_attributes_lengths[] = { 9, 18, 3, 7, 7, 8, 6, 7, 14, 16 };
+
+uint8_t checksum_get_attributes_and_arguments_for_task(
+	const uint8_t*** task_attributes, const uint8_t** task_attributes_lengths,
+	uint8_t* task_attributes_count, void* task_arguments)
+{
+	return common_get_attributes_and_arguments_for_task(
+			   checksum_attributes, checksum_attributes_lengths,
+			   COUNT_OF(checksum_attributes),
+			   task_attributes, task_attributes_lengths,
+			   task_attributes_count, task_arguments);
+}
+
+struct checksum_jobs
+{
+	uint8_t mutex[BUFFER_SIZE_OF];
+	const uint8_t** paths;
+	uint16_t* lengths;
+	uint8_t* hashes;
+	ptrdiff_t count;
+	ptrdiff_t next;
+	const struct range* algorithm_parameter;
+	uint8_t algorithm;
+};
+
+uint8_t checksum_worker(void* argument)
+{
+	struct checksum_jobs* jobs = (struct checksum_jobs*)argument;
+	uint8_t output_buffer[BUFFER_SIZE_OF];
+	void* output = (void*)output_buffer;
+
+	if (!buffer_init(output, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	while (1)
+	{
+		thread_mutex_lock(jobs->mutex);
+		const ptrdiff_t i = jobs->next++;
+		thread_mutex_unlock(jobs->mutex);
+
+		if (jobs->count <= i)
+		{
+			break;
+		}
+
+		/*NOTE: each job own the slot of the result, so only the index is taken under the lock.*/
+		if (!buffer_resize(output, 0) ||
+			!file_get_checksum_(jobs->paths[i], jobs->algorithm, jobs->algorithm_parameter, output) ||
+			CHECKSUM_MAX_HASH_LENGTH < buffer_size(output))
+		{
+			continue;
+		}
+
+		jobs->lengths[i] = (uint16_t)buffer_size(output);
+		memcpy(jobs->hashes + i * CHECKSUM_MAX_HASH_LENGTH, buffer_uint8_t_data(output, 0), jobs->lengths[i]);
+	}
+
+	buffer_release(output);
+	return 1;
+}
+
+uint8_t checksum_compute(
+	const void* paths, uint16_t threads, uint8_t algorithm,
+	const struct range* algorithm_parameter, void* output)
+{
+	const uint8_t* start = buffer_uint8_t_data(paths, 0);
+	const uint8_t* finish = start + buffer_size(paths);
+	ptrdiff_t count = 0;
+
+	for (const uint8_t* path = start; path < finish; path += 1 + common_count_bytes_until(path, 0))
+	{
+		++count;
+	}
+
+	if (!count)
+	{
+		return 1;
+	}
+
+	uint8_t slots_buffer[BUFFER_SIZE_OF];
+	void* slots = (void*)slots_buffer;
+
+	if (!buffer_init(slots, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	if (!buffer_append(slots, NULL,
+					   count * (sizeof(const uint8_t*) + sizeof(uint16_t) + CHECKSUM_MAX_HASH_LENGTH)))
+	{
+		buffer_release(slots);
+		return 0;
+	}
+
+	struct checksum_jobs jobs;
+	/**/
+	jobs.paths = (const uint8_t**)buffer_data(slots, 0);
+	jobs.lengths = (uint16_t*)(jobs.paths + count);
+	jobs.hashes = (uint8_t*)(jobs.lengths + count);
+	jobs.count = count;
+	jobs.next = 0;
+	jobs.algorithm_parameter = algorithm_parameter;
+	jobs.algorithm = algorithm;
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		jobs.paths[i] = start;
+		jobs.lengths[i] = 0;
+		start += 1 + common_count_bytes_until(start, 0);
+	}
+
+	if (!buffer_init(jobs.mutex, BUFFER_SIZE_OF))
+	{
+		buffer_release(slots);
+		return 0;
+	}
+
+	if (!thread_mutex_init(jobs.mutex))
+	{
+		thread_mutex_release(jobs.mutex);
+		buffer_release(slots);
+		return 0;
+	}
+
+	threads = (uint16_t)MIN(threads, count);
+	/*NOTE: workers do not touch the project, so other targets can be interpreted meanwhile.*/
+	thread_leave_interpreter();
+	thread_run(threads, checksum_worker, &jobs);
+	thread_enter_interpreter();
+	/**/
+	thread_mutex_release(jobs.mutex);
+
+	/*NOTE: hash of the file that was not read is left empty.*/
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		if (!buffer_append(output, jobs.hashes + i * CHECKSUM_MAX_HASH_LENGTH, jobs.lengths[i]) ||
+			!buffer_push_back(output, 0))
+		{
+			buffer_release(slots);
+			return 0;
+		}
+	}
+
+	buffer_release(slots);
+	return 1;
+}
+
+uint8_t checksum_compile_wild_cards(const void* wild_cards_in_a_buffer, void* output)
+{
+	const uint8_t* start = buffer_uint8_t_data(wild_cards_in_a_buffer, 0);
+	const uint8_t* finish = start + buffer_size(wild_cards_in_a_buffer);
+	static const uint8_t semicolon = ';';
+
+	while (start < finish)
+	{
+		const uint8_t* pos = string_find_any_symbol_like_or_not_like_that(
+								 start, finish, &semicolon, &semicolon + 1, 1, 1);
+
+		if (start < pos &&
+			!path_glob_compile(start, pos, output))
+		{
+			return 0;
+		}
+
+		start = pos + (pos < finish);
+	}
+
+	return 1;
+}
+
+const uint8_t* checksum_get_relative_path(const uint8_t* path, ptrdiff_t dir_size)
+{
+	path += dir_size;
+	return path + (PATH_DELIMITER == *path);
+}
+
+int checksum_compare_paths(const void* a, const void* b)
+{
+	const struct range* path_a = (const struct range*)a;
+	const struct range* path_b = (const struct range*)b;
+	const ptrdiff_t length_a = range_size(path_a);
+	const ptrdiff_t length_b = range_size(path_b);
+	const int result = memcmp(path_a->start, path_b->start, MIN(length_a, length_b));
+
+	if (result)
+	{
+		return result;
+	}
+
+	return length_a < length_b ? -1 : (length_b < length_a ? 1 : 0);
+}
+
+uint8_t checksum_sort_paths(void* paths)
+{
+	uint8_t ranges_buffer[BUFFER_SIZE_OF];
+	void* ranges = (void*)ranges_buffer;
+
+	if (!buffer_init(ranges, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	const uint8_t* start = buffer_uint8_t_data(paths, 0);
+	const uint8_t* finish = start + buffer_size(paths);
+	struct range path;
+
+	while (start < finish)
+	{
+		path.start = start;
+		path.finish = start + common_count_bytes_until(start, 0);
+
+		if (!buffer_append(ranges, (const uint8_t*)&path, sizeof(struct range)))
+		{
+			buffer_release(ranges);
+			return 0;
+		}
+
+		start = path.finish + 1;
+	}
+
+	const ptrdiff_t count = buffer_size(ranges) / sizeof(struct range);
+
+	if (count < 2)
+	{
+		buffer_release(ranges);
+		return 1;
+	}
+
+	const ptrdiff_t size = buffer_size(ranges);
+	const ptrdiff_t paths_size = buffer_size(paths);
+
+	/*NOTE: sorted paths are collected after the ranges, than copied over the source ones.*/
+	if (!buffer_append(ranges, NULL, paths_size) ||
+		!buffer_resize(ranges, size))
+	{
+		buffer_release(ranges);
+		return 0;
+	}
+
+	struct range* sorted = (struct range*)buffer_data(ranges, 0);
+	qsort(sorted, count, sizeof(struct range), checksum_compare_paths);
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		if (!buffer_append(ranges, sorted[i].start, range_size(&sorted[i]) + 1))
+		{
+			buffer_release(ranges);
+			return 0;
+		}
+	}
+
+	memcpy(buffer_uint8_t_data(paths, 0), buffer_data(ranges, size), paths_size);
+	buffer_release(ranges);
+	return 1;
+}
+
+uint8_t checksum_enumerate(
+	void* dir_in_a_buffer, const uint8_t* manifest,
+	const void* include, const void* exclude, uint16_t threads, void* output)
+{
+	const ptrdiff_t dir_size = buffer_size(dir_in_a_buffer);
+
+	if (!buffer_push_back(dir_in_a_buffer, 0) ||
+		!directory_enumerate_file_system_entries(
+			dir_in_a_buffer, file_system_get_id_of_file_entry(), 1, exclude, output, 1, threads))
+	{
+		return 0;
+	}
+
+	const uint8_t* start = buffer_uint8_t_data(output, 0);
+	const uint8_t* finish = start + buffer_size(output);
+	const ptrdiff_t manifest_length = common_count_bytes_until(manifest, 0);
+	ptrdiff_t size = 0;
+
+	/*NOTE: entries are filtered in place, so the manifest itself and files that not included are dropped.
+	  Both directory and manifest are full paths, so the manifest is matched at any spelling set in the script.*/
+	while (start < finish)
+	{
+		const ptrdiff_t length = common_count_bytes_until(start, 0);
+		const uint8_t* relative_start = checksum_get_relative_path(start, dir_size);
+		const uint8_t* relative_finish = start + length;
+
+		if (!string_equal(start, relative_finish, manifest, manifest + manifest_length) &&
+			(NULL == include ||
+			 path_glob_compiled(include, relative_start, relative_finish, path_glob_match)) &&
+			(NULL == exclude ||
+			 !path_glob_compiled(exclude, relative_start, relative_finish, path_glob_match)))
+		{
+			uint8_t* destination = buffer_uint8_t_data(output, size);
+			memmove(destination, start, length + 1);
+			size += length + 1;
+		}
+
+		start += length + 1;
+	}
+
+	/*NOTE: order of the file system enumeration is not defined, so paths are sorted to get the same manifest.*/
+	return buffer_resize(output, size) &&
+		   checksum_sort_paths(output);
+}
+
+uint8_t checksum_parse_manifest(
+	const uint8_t* start, const uint8_t* finish,
+	const void* dir_in_a_buffer, void* names, void* paths, void* hashes)
+{
+	static const uint8_t new_line = '\n';
+	const ptrdiff_t dir_size = buffer_size(dir_in_a_buffer);
+
+	while (start < finish)
+	{
+		const uint8_t* line_finish = string_find_any_symbol_like_or_not_like_that(
+										 start, finish, &new_line, &new_line + 1, 1, 1);
+		struct range line;
+		line.start = start;
+		line.finish = line_finish;
+		start = line_finish + (line_finish < finish);
+
+		if (line.start < line.finish &&
+			'\r' == *(line.finish - 1))
+		{
+			--line.finish;
+		}
+
+		if (line.start == line.finish)
+		{
+			continue;
+		}
+
+		/*NOTE: line is '<hash>  <path>' or '<hash> *<path>' as the sum utilities write it.*/
+		const uint8_t* pos = line.start;
+
+		while (pos < line.finish && ' ' != *pos)
+		{
+			++pos;
+		}
+
+		if (line.start == pos ||
+			line.finish - pos < 3 ||
+			(' ' != pos[1] && '*' != pos[1]))
+		{
+			return 0;
+		}
+
+		struct range name;
+		name.start = pos + 2;
+		name.finish = line.finish;
+		line.finish = pos;
+		uint8_t is_path_rooted = 0;
+
+		if (!path_is_path_rooted(name.start, name.finish, &is_path_rooted) ||
+			!buffer_append_range(names, &name, 1) ||
+			!buffer_append_range(hashes, &line, 1))
+		{
+			return 0;
+		}
+
+		const ptrdiff_t size = buffer_size(paths);
+
+		if (is_path_rooted)
+		{
+			if (!buffer_append(paths, name.start, name.finish - name.start))
+			{
+				return 0;
+			}
+		}
+		else
+		{
+			if (!buffer_append(paths, buffer_uint8_t_data(dir_in_a_buffer, 0), dir_size) ||
+				!path_combine_in_place(paths, size, name.start, name.finish))
+			{
+				return 0;
+			}
+		}
+
+		if (!buffer_push_back(paths, 0))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t checksum_report(
+	const struct range* name, uint8_t is_read, void* mismatches, void* output)
+{
+	static const uint8_t* mismatch = (const uint8_t*)"Checksum mismatch of '";
+	static const uint8_t* failed = (const uint8_t*)"Failed to read '";
+	static const uint8_t* end = (const uint8_t*)"'.";
+	static const uint8_t semicolon = ';';
+
+	if ((buffer_size(mismatches) && !buffer_push_back(mismatches, semicolon)) ||
+		!buffer_append(mismatches, name->start, name->finish - name->start))
+	{
+		return 0;
+	}
+
+	if (!buffer_resize(output, 0) ||
+		!buffer_append(output, is_read ? mismatch : failed, is_read ? 22 : 16) ||
+		!buffer_append(output, name->start, name->finish - name->start) ||
+		!buffer_append(output, end, 2))
+	{
+		return 0;
+	}
+
+	return echo(0, Default, NULL, Warning, buffer_uint8_t_data(output, 0), buffer_size(output), 1, 0);
+}
+
+uint8_t checksum_verify(
+	void* the_project, const uint8_t* manifest, void* dir_in_a_buffer,
+	uint16_t threads, uint8_t algorithm, const struct range* algorithm_parameter,
+	void* task_arguments, void* content, uint8_t verbose)
+{
+	if (!buffer_resize(content, 0) ||
+		!file_read_all(manifest, content))
+	{
+		return 0;
+	}
+
+	const ptrdiff_t content_size = buffer_size(content);
+	/*NOTE: layout of the content buffer is - manifest, parsed names and expected hashes, paths and computed hashes.*/
+	uint8_t names_buffer[BUFFER_SIZE_OF];
+	void* names = (void*)names_buffer;
+
+	if (!buffer_init(names, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	uint8_t hashes_buffer[BUFFER_SIZE_OF];
+	void* hashes = (void*)hashes_buffer;
+
+	if (!buffer_init(hashes, BUFFER_SIZE_OF))
+	{
+		buffer_release(names);
+		return 0;
+	}
+
+	void* paths = buffer_buffer_data(task_arguments, CHECKSUM_INCLUDE_POSITION);
+	void* computed = buffer_buffer_data(task_arguments, CHECKSUM_EXCLUDE_POSITION);
+	const uint8_t* start = buffer_uint8_t_data(content, 0);
+
+	if (!buffer_resize(paths, 0) ||
+		!buffer_resize(computed, 0) ||
+		!checksum_parse_manifest(start, start + content_size, dir_in_a_buffer, names, paths, hashes) ||
+		!checksum_compute(paths, threads, algorithm, algorithm_parameter, computed))
+	{
+		buffer_release(hashes);
+		buffer_release(names);
+		return 0;
+	}
+
+	/*NOTE: buffers of the attributes that are already read or not used at verification are reused.*/
+	void* mismatches = buffer_buffer_data(task_arguments, CHECKSUM_VERIFY_POSITION);
+	void* message = buffer_buffer_data(task_arguments, CHECKSUM_THREADS_POSITION);
+	/**/
+	const struct range* name = buffer_range_data(names, 0);
+	const struct range* expected = buffer_range_data(hashes, 0);
+	const ptrdiff_t count = buffer_size(names) / sizeof(struct range);
+	/**/
+	start = buffer_uint8_t_data(computed, 0);
+	int64_t failed = 0;
+
+	if (!buffer_resize(mismatches, 0))
+	{
+		buffer_release(hashes);
+		buffer_release(names);
+		return 0;
+	}
+
+	for (ptrdiff_t i = 0; i < count; ++i)
+	{
+		const ptrdiff_t length = common_count_bytes_until(start, 0);
+
+		if (!string_equal(start, start + length, expected[i].start, expected[i].finish))
+		{
+			if (!checksum_report(&name[i], 0 < length, mismatches, message))
+			{
+				buffer_release(hashes);
+				buffer_release(names);
+				return 0;
+			}
+
+			++failed;
+		}
+
+		start += length + 1;
+	}
+
+	buffer_release(hashes);
+	buffer_release(names);
+	/**/
+	const void* result_property_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_RESULT_PROPERTY_POSITION);
+	const ptrdiff_t result_property_size = buffer_size(result_property_in_a_buffer);
+
+	if (result_property_size)
+	{
+		if (!buffer_resize(message, 0) ||
+			!int64_to_string(failed, message) ||
+			!project_property_set_value(the_project, buffer_uint8_t_data(result_property_in_a_buffer, 0),
+										(uint8_t)result_property_size,
+										buffer_uint8_t_data(message, 0), buffer_size(message),
+										0, 1, 0, verbose))
+		{
+			return 0;
+		}
+	}
+
+	const void* mismatch_property_in_a_buffer = buffer_buffer_data(task_arguments,
+			CHECKSUM_MISMATCH_PROPERTY_POSITION);
+	const ptrdiff_t mismatch_property_size = buffer_size(mismatch_property_in_a_buffer);
+
+	if (mismatch_property_size)
+	{
+		/*NOTE: zero is added so the value is not a null pointer when all files matched.*/
+		if (!buffer_push_back(mismatches, 0) ||
+			!project_property_set_value(the_project, buffer_uint8_t_data(mismatch_property_in_a_buffer, 0),
+										(uint8_t)mismatch_property_size,
+										buffer_uint8_t_data(mismatches, 0), buffer_size(mismatches) - 1,
+										0, 1, 0, verbose))
+		{
+			return 0;
+		}
+	}
+
+	/*NOTE: when mismatches are reported through the properties, script decide what to do with them.*/
+	return !failed || result_property_size || mismatch_property_size;
+}
+
+uint8_t checksum_generate(
+	const uint8_t* manifest, void* dir_in_a_buffer,
+	uint16_t threads, uint8_t algorithm, const struct range* algorithm_parameter,
+	void* task_arguments, void* content)
+{
+	void* include_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_INCLUDE_POSITION);
+	void* exclude_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_EXCLUDE_POSITION);
+	/*NOTE: buffers of the attributes, that are already read or not used at generation, keep compiled wild cards.*/
+	void* include = buffer_buffer_data(task_arguments, CHECKSUM_VERIFY_POSITION);
+	void* exclude = buffer_buffer_data(task_arguments, CHECKSUM_RESULT_PROPERTY_POSITION);
+
+	if (!buffer_resize(include, 0) ||
+		!buffer_resize(exclude, 0) ||
+		!checksum_compile_wild_cards(include_in_a_buffer, include) ||
+		!checksum_compile_wild_cards(exclude_in_a_buffer, exclude))
+	{
+		return 0;
+	}
+
+	const ptrdiff_t dir_size = buffer_size(dir_in_a_buffer);
+	void* paths = include_in_a_buffer;
+	void* computed = exclude_in_a_buffer;
+
+	if (!buffer_resize(paths, 0) ||
+		!checksum_enumerate(dir_in_a_buffer, manifest,
+							buffer_size(include) ? include : NULL,
+							buffer_size(exclude) ? exclude : NULL, threads, paths) ||
+		!buffer_resize(computed, 0) ||
+		!checksum_compute(paths, threads, algorithm, algorithm_parameter, computed) ||
+		!buffer_resize(content, 0))
+	{
+		return 0;
+	}
+
+	const uint8_t* path = buffer_uint8_t_data(paths, 0);
+	const uint8_t* finish = path + buffer_size(paths);
+	const uint8_t* hash = buffer_uint8_t_data(computed, 0);
+	static const uint8_t* delimiter = (const uint8_t*)"  ";
+	static const uint8_t new_line = '\n';
+
+	while (path < finish)
+	{
+		const ptrdiff_t path_length = common_count_bytes_until(path, 0);
+		const ptrdiff_t hash_length = common_count_bytes_until(hash, 0);
+		const uint8_t* relative_path = checksum_get_relative_path(path, dir_size);
+
+		if (!hash_length)
+		{
+			static const uint8_t* failed = (const uint8_t*)"Failed to read '";
+			static const uint8_t* end = (const uint8_t*)"'.";
+
+			if (!buffer_resize(content, 0) ||
+				!buffer_append(content, failed, 16) ||
+				!buffer_append(content, path, path_length) ||
+				!buffer_append(content, end, 2))
+			{
+				return 0;
+			}
+
+			echo(0, Default, NULL, Error, buffer_uint8_t_data(content, 0), buffer_size(content), 1, 0);
+			return 0;
+		}
+
+		if (!buffer_append(content, hash, hash_length) ||
+			!buffer_append(content, delimiter, 2) ||
+			!buffer_append(content, relative_path, path + path_length - relative_path) ||
+			!buffer_push_back(content, new_line))
+		{
+			return 0;
+		}
+
+		path += path_length + 1;
+		hash += hash_length + 1;
+	}
+
+	return file_write_all(manifest, content);
+}
+
+uint8_t checksum_get_full_path(
+	const void* the_project, const void* the_target, void* path, void* content, uint8_t verbose)
+{
+	if (!buffer_resize(content, 0) ||
+		!project_get_current_directory(the_project, the_target, content, 0, verbose))
+	{
+		return 0;
+	}
+
+	uint8_t full_path_buffer[BUFFER_SIZE_OF];
+	void* full_path = (void*)full_path_buffer;
+
+	if (!buffer_init(full_path, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	const uint8_t* root = buffer_uint8_t_data(content, 0);
+	const uint8_t* start = buffer_uint8_t_data(path, 0);
+
+	if (!path_get_full_path(root, root + buffer_size(content),
+							start, start + buffer_size(path), full_path) ||
+		!buffer_resize(path, 0) ||
+		!buffer_append_data_from_buffer(path, full_path))
+	{
+		buffer_release(full_path);
+		return 0;
+	}
+
+	buffer_release(full_path);
+	return 1;
+}
+
+uint8_t checksum_evaluate_task(
+	void* the_project, const void* the_target, void* task_arguments, uint8_t verbose)
+{
+	if (NULL == the_project ||
+		NULL == task_arguments)
+	{
+		return 0;
+	}
+
+	const void* algorithm_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_ALGORITHM_POSITION);
+	const uint8_t* value = buffer_uint8_t_data(algorithm_in_a_buffer, 0);
+	const uint8_t algorithm = (uint8_t)common_string_to_enum(
+								  value, value + buffer_size(algorithm_in_a_buffer),
+								  hash_function_str, UNKNOWN_HASH_FUNCTION);
+
+	if (bytes_to_string == algorithm ||
+		UNKNOWN_HASH_FUNCTION == algorithm)
+	{
+		return 0;
+	}
+
+	const void* algorithm_parameter_in_a_buffer = buffer_buffer_data(task_arguments,
+			CHECKSUM_ALGORITHM_PARAMETER_POSITION);
+	struct range algorithm_parameter;
+
+	BUFFER_TO_RANGE(algorithm_parameter, algorithm_parameter_in_a_buffer);
+	/**/
+	void* manifest_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_MANIFEST_POSITION);
+
+	if (!buffer_size(manifest_in_a_buffer))
+	{
+		return 0;
+	}
+
+	uint8_t verify = 0;
+	void* verify_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_VERIFY_POSITION);
+	ptrdiff_t size = buffer_size(verify_in_a_buffer);
+
+	if (size)
+	{
+		value = buffer_uint8_t_data(verify_in_a_buffer, 0);
+
+		if (!bool_parse(value, value + size, &verify))
+		{
+			return 0;
+		}
+	}
+
+	uint16_t threads = common_get_jobs();
+	void* threads_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_THREADS_POSITION);
+	size = buffer_size(threads_in_a_buffer);
+
+	if (size)
+	{
+		value = buffer_uint8_t_data(threads_in_a_buffer, 0);
+		const uint64_t count = uint64_parse(value, value + size);
+		threads = (uint16_t)MIN(count, UINT16_MAX);
+	}
+
+	uint8_t content_buffer[BUFFER_SIZE_OF];
+	void* content = (void*)content_buffer;
+
+	if (!buffer_init(content, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	void* dir_in_a_buffer = buffer_buffer_data(task_arguments, CHECKSUM_DIR_POSITION);
+
+	if (!checksum_get_full_path(the_project, the_target, manifest_in_a_buffer, content, verbose) ||
+		!buffer_push_back(manifest_in_a_buffer, 0) ||
+		(!buffer_size(dir_in_a_buffer) &&
+		 !project_get_current_directory(the_project, the_target, dir_in_a_buffer, 0, verbose)) ||
+		!checksum_get_full_path(the_project, the_target, dir_in_a_buffer, content, verbose))
+	{
+		buffer_release(content);
+		return 0;
+	}
+
+	const uint8_t* manifest = buffer_uint8_t_data(manifest_in_a_buffer, 0);
+	size = buffer_size(dir_in_a_buffer);
+
+	/*NOTE: trailing delimiter is removed, so relative paths start right after the directory.*/
+	while (1 < size &&
+		   PATH_DELIMITER == *buffer_uint8_t_data(dir_in_a_buffer, size - 1))
+	{
+		--size;
+	}
+
+	if (!buffer_resize(dir_in_a_buffer, size) ||
+		!buffer_push_back(dir_in_a_buffer, 0) ||
+		!directory_exists(buffer_uint8_t_data(dir_in_a_buffer, 0)) ||
+		!buffer_resize(dir_in_a_buffer, size))
+	{
+		buffer_release(content);
+		return 0;
+	}
+
+	const uint8_t returned = verify ?
+							 checksum_verify(the_project, manifest, dir_in_a_buffer, threads, algorithm,
+											 &algorithm_parameter, task_arguments, content, verbose) :
+							 checksum_generate(manifest, dir_in_a_buffer, threads, algorithm,
+									 &algorithm_parameter, task_arguments, content);
+	buffer_release(content);
+	return returned;
+}
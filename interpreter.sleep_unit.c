@@ -11,6 +11,7 @@
 #include "common.h"
 #include "conversion.h"
 #include "date_time.h"
+#include "thread.h"
 
 #define HOURS_POSITION			0
 #define MILLISECONDS_POSITION	1
@@ -92,5 +93,9 @@ uint8_t sleep_unit_evaluate_task(void* task_arguments, uint8_t verbose)
 		return 0;
 	}
 
-	return sleep_for((uint32_t)milliseconds);
+	thread_leave_interpreter();
+	counter = sleep_for((uint32_t)milliseconds);
+	thread_enter_interpreter();
+	/**/
+	return counter;
 }
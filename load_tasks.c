@@ -364,7 +364,7 @@ uint8_t load_tasks_evaluate_task(void* the_project, const void* the_target,
 		}
 
 		if (!buffer_resize(path_to_module_in_a_buffer, 0) ||
-			!directory_enumerate_file_system_entries(path_in_a_buffer, 1, 0, path_to_module_in_a_buffer, 1))
+			!directory_enumerate_file_system_entries(path_in_a_buffer, 1, 0, NULL, path_to_module_in_a_buffer, 1, 1))
 		{
 			return 0;
 		}
@@ -583,7 +583,7 @@ uint8_t load_tasks_evaluate_loaded_task(
 			return 0;
 		}
 
-		if (xml_get_sub_nodes_elements(output, output + output_length, NULL, elements))
+		if (xml_get_sub_nodes_elements(NULL, output, output + output_length, NULL, elements))
 		{
 			return interpreter_evaluate_tasks(the_project, the_target, elements, NULL, 0, verbose);
 		}
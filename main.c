@@ -74,10 +74,12 @@
 	"\t-nologo - do not display program version, license, copyright information and STATUS of completed script.\n"				\
 	"\t-listener: - set path to the module with listener.\n"																	\
 	"\t-modulepriority - first try to evaluate tasks and functions from modules than from core of the library.\n"				\
+	"\t-jobs: - set count of targets that can be evaluated at the same time. Zero value mean count of processors.\n"			\
 	"\t-debug - display message with Debug level.\n"																			\
 	"\t-logfile: - set path to the file for logging. Short form -l:.\n"															\
 	"\t-verbose - display message with Verbose level. Set verbose parameter of functions to the true. Short form -v.\n"			\
 	"\t-quiet - display messages only with Warning or/and Error levels. Short form -q.\n"										\
+	"\t-statcache - cache status of file system entries during the run, entries changed by the tasks are refreshed.\n"		\
 	"\t-help - print this message. Short form -h."
 #define OPTIONS_LENGTH common_count_bytes_until(OPTIONS, 0)
 
@@ -121,6 +123,48 @@ uint8_t print_elapsed_time(int64_t delta, void* argument_value)
 	return 1;
 }
 
+uint8_t print_stat_cache_statistics(void* argument_value)
+{
+	ptrdiff_t saved = 0;
+	ptrdiff_t performed = 0;
+	file_system_get_stat_cache_statistics(&saved, &performed);
+
+	if (!buffer_resize(argument_value, 0) ||
+		!buffer_append_char(argument_value, "Stat cache: saved ", 18) ||
+		!int64_to_string(saved, argument_value) ||
+		!buffer_append_char(argument_value, " of ", 4) ||
+		!int64_to_string(saved + performed, argument_value) ||
+		!buffer_append_char(argument_value, " call(s).", 9))
+	{
+		return 0;
+	}
+
+	return echo(
+			   0, Default, NULL, Verbose,
+			   buffer_uint8_t_data(argument_value, 0), buffer_size(argument_value), 1, 1);
+}
+
+uint8_t print_pool_statistics(void* argument_value)
+{
+	ptrdiff_t hits = 0;
+	ptrdiff_t misses = 0;
+	buffer_get_pool_statistics(&hits, &misses);
+
+	if (!buffer_resize(argument_value, 0) ||
+		!buffer_append_char(argument_value, "Buffer pool: reused ", 20) ||
+		!int64_to_string(hits, argument_value) ||
+		!buffer_append_char(argument_value, " of ", 4) ||
+		!int64_to_string(hits + misses, argument_value) ||
+		!buffer_append_char(argument_value, " buffer(s).", 11))
+	{
+		return 0;
+	}
+
+	return echo(
+			   0, Default, NULL, Verbose,
+			   buffer_uint8_t_data(argument_value, 0), buffer_size(argument_value), 1, 1);
+}
+
 #if defined(_MSC_VER)
 int wmain(int argc, wchar_t** argv)
 #else
@@ -196,6 +240,8 @@ int main(int argc, char** argv)
 	}
 
 	common_set_module_priority(argument_parser_get_module_priority());
+	common_set_jobs(argument_parser_get_jobs());
+	file_system_set_stat_cache(argument_parser_get_stat_cache());
 	uint8_t current_directory[BUFFER_SIZE_OF];
 
 	if (!buffer_init((void*)current_directory, BUFFER_SIZE_OF))
@@ -392,6 +438,21 @@ int main(int argc, char** argv)
 
 	project_unload((void*)the_project);
 	shared_object_unload(listener_object);
+
+	if (verbose &&
+		argument_parser_get_stat_cache())
+	{
+		print_stat_cache_statistics((void*)current_directory);
+	}
+
+	file_system_release_stat_cache();
+	buffer_release_pool();
+
+	if (verbose)
+	{
+		print_pool_statistics((void*)current_directory);
+	}
+
 	/**/
 	time_now = datetime_now() - time_now;
 
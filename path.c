@@ -968,6 +968,270 @@ uint8_t path_glob(
 	return 1;
 }
 
+#define PATH_GLOB_LITERAL			0
+#define PATH_GLOB_WILD_CARD			1
+#define PATH_GLOB_ANY_DIRECTORIES	2
+#define PATH_GLOB_ALTERNATIVE		3
+
+uint8_t path_glob_is_delimiter(uint8_t symbol)
+{
+	return path_posix_delimiter == symbol || PATH_DELIMITER == symbol;
+}
+
+const uint8_t* path_glob_get_part_finish(const uint8_t* start, const uint8_t* finish)
+{
+	while (start < finish && !path_glob_is_delimiter(*start))
+	{
+		++start;
+	}
+
+	return start;
+}
+
+uint8_t path_glob_compile(
+	const uint8_t* wild_card_start, const uint8_t* wild_card_finish,
+	void* output)
+{
+	if (range_in_parts_is_null_or_empty(wild_card_start, wild_card_finish) ||
+		NULL == output)
+	{
+		return 0;
+	}
+
+	/*NOTE: each compiled wild card is added as alternative to the already compiled ones.*/
+	if (buffer_size(output) &&
+		(!buffer_push_back(output, PATH_GLOB_ALTERNATIVE) ||
+		 !buffer_push_back(output, 0)))
+	{
+		return 0;
+	}
+
+	const ptrdiff_t size = buffer_size(output);
+	uint8_t previous_kind = PATH_GLOB_LITERAL;
+
+	while (wild_card_start < wild_card_finish)
+	{
+		const uint8_t* part_finish = path_glob_get_part_finish(wild_card_start, wild_card_finish);
+		const ptrdiff_t length = part_finish - wild_card_start;
+
+		if (length)
+		{
+			uint8_t kind = PATH_GLOB_LITERAL;
+
+			if (2 == length && '*' == wild_card_start[0] && '*' == wild_card_start[1])
+			{
+				kind = PATH_GLOB_ANY_DIRECTORIES;
+			}
+			else
+			{
+				for (ptrdiff_t i = 0; i < length; ++i)
+				{
+					if ('*' == wild_card_start[i] || '?' == wild_card_start[i])
+					{
+						kind = PATH_GLOB_WILD_CARD;
+						break;
+					}
+				}
+			}
+
+			/*NOTE: several '**' in a row match the same as one.*/
+			if ((PATH_GLOB_ANY_DIRECTORIES != kind || kind != previous_kind) &&
+				(!buffer_push_back(output, kind) ||
+				 !buffer_append(output, wild_card_start, length) ||
+				 !buffer_push_back(output, 0)))
+			{
+				return 0;
+			}
+
+			previous_kind = kind;
+		}
+
+		wild_card_start = part_finish + (part_finish < wild_card_finish);
+	}
+
+	return size < buffer_size(output);
+}
+
+uint8_t path_glob_part(
+	const uint8_t* wild_card_start, const uint8_t* wild_card_finish,
+	const uint8_t* part_start, const uint8_t* part_finish)
+{
+	const uint8_t* asterisk = NULL;
+	const uint8_t* resume = NULL;
+
+	while (part_start < part_finish)
+	{
+		if (wild_card_start < wild_card_finish &&
+			'*' == *wild_card_start)
+		{
+			asterisk = ++wild_card_start;
+			resume = part_start;
+			continue;
+		}
+
+		if (wild_card_start < wild_card_finish &&
+			('?' == *wild_card_start || *part_start == *wild_card_start))
+		{
+			/*NOTE: '?' match one symbol, so continuation bytes of the UTF-8 sequence are skipped with it.*/
+			const uint8_t is_question_mark = '?' == *wild_card_start;
+			++wild_card_start;
+			++part_start;
+
+			while (is_question_mark && part_start < part_finish && 0x80 == (*part_start & 0xC0))
+			{
+				++part_start;
+			}
+
+			continue;
+		}
+
+		if (NULL == asterisk)
+		{
+			return 0;
+		}
+
+		wild_card_start = asterisk;
+		part_start = ++resume;
+	}
+
+	while (wild_card_start < wild_card_finish &&
+		   '*' == *wild_card_start)
+	{
+		++wild_card_start;
+	}
+
+	return wild_card_start == wild_card_finish;
+}
+
+uint8_t path_glob_compiled_from(
+	const uint8_t* segment, const uint8_t* segments_finish,
+	const uint8_t* path_start, const uint8_t* path_finish,
+	enum path_glob_mode mode)
+{
+	while (segment < segments_finish)
+	{
+		const uint8_t kind = *segment;
+		const uint8_t* value = segment + 1;
+		const ptrdiff_t length = common_count_bytes_until(value, 0);
+		segment = value + length + 1;
+
+		if (PATH_GLOB_ALTERNATIVE == kind)
+		{
+			break;
+		}
+
+		if (PATH_GLOB_ANY_DIRECTORIES == kind)
+		{
+			if (segment == segments_finish ||
+				PATH_GLOB_ALTERNATIVE == *segment)
+			{
+				return 1;
+			}
+
+			if (path_glob_match == mode)
+			{
+				/*NOTE: when no other '**' follow, only the last parts of the path can match the rest segments.*/
+				ptrdiff_t count = 0;
+				const uint8_t* next = segment;
+
+				while (next < segments_finish &&
+					   PATH_GLOB_ALTERNATIVE != *next &&
+					   PATH_GLOB_ANY_DIRECTORIES != *next)
+				{
+					next += 2 + common_count_bytes_until(next + 1, 0);
+					++count;
+				}
+
+				if (next == segments_finish ||
+					PATH_GLOB_ALTERNATIVE == *next)
+				{
+					const uint8_t* start = path_finish;
+
+					while (path_start < start)
+					{
+						if (path_glob_is_delimiter(*(start - 1)) && 0 == --count)
+						{
+							break;
+						}
+
+						--start;
+					}
+
+					return (path_start == start ? 1 == count : 1) &&
+						   path_glob_compiled_from(segment, segments_finish, start, path_finish, mode);
+				}
+			}
+
+			while (1)
+			{
+				if (path_glob_compiled_from(segment, segments_finish, path_start, path_finish, mode))
+				{
+					return 1;
+				}
+
+				if (path_start == path_finish)
+				{
+					return 0;
+				}
+
+				path_start = path_glob_get_part_finish(path_start, path_finish);
+				path_start += path_start < path_finish;
+			}
+		}
+
+		if (path_start == path_finish)
+		{
+			return path_glob_may_match_under == mode;
+		}
+
+		const uint8_t* part_finish = path_glob_get_part_finish(path_start, path_finish);
+
+		if (PATH_GLOB_LITERAL == kind ?
+			(length != part_finish - path_start || 0 != memcmp(value, path_start, length)) :
+			!path_glob_part(value, value + length, path_start, part_finish))
+		{
+			return 0;
+		}
+
+		path_start = part_finish + (part_finish < path_finish);
+	}
+
+	return path_start == path_finish && path_glob_match == mode;
+}
+
+uint8_t path_glob_compiled(
+	const void* compiled,
+	const uint8_t* path_start, const uint8_t* path_finish,
+	enum path_glob_mode mode)
+{
+	if (NULL == compiled ||
+		path_finish < path_start)
+	{
+		return 0;
+	}
+
+	const uint8_t* segments_start = buffer_uint8_t_data(compiled, 0);
+	const uint8_t* segments_finish = segments_start + buffer_size(compiled);
+
+	while (segments_start < segments_finish)
+	{
+		if (path_glob_compiled_from(segments_start, segments_finish, path_start, path_finish, mode))
+		{
+			return 1;
+		}
+
+		while (segments_start < segments_finish &&
+			   PATH_GLOB_ALTERNATIVE != *segments_start)
+		{
+			segments_start += 2 + common_count_bytes_until(segments_start + 1, 0);
+		}
+
+		segments_start += 2;
+	}
+
+	return 0;
+}
+
 uint8_t path_get_directory_for_current_process(void* path)
 {
 	if (NULL == path)
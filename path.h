@@ -59,6 +59,16 @@ uint8_t path_glob(
 	const uint8_t* path_start, const uint8_t* path_finish,
 	const uint8_t* wild_card_start, const uint8_t* wild_card_finish);
 
+enum path_glob_mode { path_glob_match, path_glob_may_match_under, path_glob_match_all_under };
+
+uint8_t path_glob_compile(
+	const uint8_t* wild_card_start, const uint8_t* wild_card_finish,
+	void* output);
+uint8_t path_glob_compiled(
+	const void* compiled,
+	const uint8_t* path_start, const uint8_t* path_finish,
+	enum path_glob_mode mode);
+
 uint8_t path_get_directory_for_current_process(void* path);
 uint8_t path_get_directory_for_current_image(void* path);
 
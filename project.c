@@ -60,7 +60,10 @@ static const uint8_t project_attributes_count = 3;
 
 #define MODULES_POSITION		7
 
-#define COUNT_OF_POSITIONS	(MODULES_POSITION + 1)
+#define COMPILED_CODE_POSITION	8
+#define XML_INDEX_POSITION		9
+
+#define COUNT_OF_POSITIONS	(XML_INDEX_POSITION + 1)
 
 uint8_t project_property_exists(
 	const void* the_project,
@@ -243,6 +246,21 @@ const uint8_t* project_get_function_from_module(
 	return load_tasks_get_function(modules, name_space, function_name, the_module_of_task, name_space_at_module);
 }
 
+const void* project_get_xml_index(const void* the_project)
+{
+	return buffer_buffer_data(the_project, XML_INDEX_POSITION);
+}
+
+void* project_get_compiled_code_cache(const void* the_project)
+{
+	if (NULL == the_project)
+	{
+		return NULL;
+	}
+
+	return buffer_buffer_data(the_project, COMPILED_CODE_POSITION);
+}
+
 uint8_t project_get_base_directory(
 	const void* the_project, const void** the_property, uint8_t verbose)
 {
@@ -411,9 +429,11 @@ uint8_t project_load(void* the_project, uint8_t project_help, uint8_t verbose)
 	sub_nodes_names.finish = sub_nodes_names.start + tags_length;
 	void* elements = buffer_buffer_data(the_project, ELEMENTS_POSITION);
 
-	if (!buffer_resize(elements, 0) ||
+	if (!xml_index_new(content_in_the_range.start, content_in_the_range.finish,
+					   buffer_buffer_data(the_project, XML_INDEX_POSITION)) ||
+		!buffer_resize(elements, 0) ||
 		1 != xml_get_sub_nodes_elements(
-			content_in_the_range.start, content_in_the_range.finish,
+			project_get_xml_index(the_project), content_in_the_range.start, content_in_the_range.finish,
 			project_help ? &sub_nodes_names : NULL, elements))
 	{
 		return 0;
@@ -435,6 +455,7 @@ uint8_t project_load_from_content(
 	}
 
 	void* content = buffer_buffer_data(the_project, CONTENT_POSITION);
+	xml_index_release(buffer_buffer_data(the_project, XML_INDEX_POSITION));
 
 	if (!buffer_resize(content, 0) ||
 		!buffer_append(content, content_start, content_finish - content_start))
@@ -459,6 +480,7 @@ uint8_t project_load_from_build_file(
 	}
 
 	void* content = buffer_buffer_data(the_project, CONTENT_POSITION);;
+	xml_index_release(buffer_buffer_data(the_project, XML_INDEX_POSITION));
 
 	if (!path_get_full_path(
 			current_directory->start, current_directory->finish,
@@ -628,6 +650,7 @@ void project_clear(void* the_project)
 	void* modules = buffer_buffer_data(the_project, MODULES_POSITION);
 	property_release_inner(private_properties);
 	buffer_resize(private_properties, 0);
+	xml_index_release(buffer_buffer_data(the_project, XML_INDEX_POSITION));
 
 	for (uint8_t i = CONTENT_POSITION; i <= LISTENER_TASK_NAME; ++i)
 	{
@@ -641,6 +664,9 @@ void project_clear(void* the_project)
 	buffer_resize(targets, 0);
 	load_tasks_unload(modules);
 	buffer_resize(modules, 0);
+	void* compiled_code = buffer_buffer_data(the_project, COMPILED_CODE_POSITION);
+	buffer_release_inner_buffers(compiled_code);
+	buffer_resize(compiled_code, 0);
 }
 
 void project_unload(void* the_project)
@@ -655,6 +681,7 @@ void project_unload(void* the_project)
 	void* targets = buffer_buffer_data(the_project, TARGETS_POSITION);
 	void* modules = buffer_buffer_data(the_project, MODULES_POSITION);
 	property_release(private_properties);
+	xml_index_release(buffer_buffer_data(the_project, XML_INDEX_POSITION));
 
 	for (uint8_t i = CONTENT_POSITION; i <= LISTENER_TASK_NAME; ++i)
 	{
@@ -666,6 +693,7 @@ void project_unload(void* the_project)
 	target_release(targets);
 	load_tasks_unload(modules);
 	buffer_release(modules);
+	buffer_release_with_inner_buffers(buffer_buffer_data(the_project, COMPILED_CODE_POSITION));
 	buffer_release(the_project);
 }
 
@@ -771,7 +799,7 @@ uint8_t project_get_build_files_from_directory(
 		return 0;
 	}
 
-	if (directory_enumerate_file_system_entries(directory, 1, 0, files, 1) &&
+	if (directory_enumerate_file_system_entries(directory, 1, 0, NULL, files, 1, 1) &&
 		buffer_size(files))
 	{
 		static const uint8_t zero_symbol = '\0';
@@ -1088,7 +1116,8 @@ uint8_t project_evaluate_task(
 
 	uint8_t returned = 1;
 
-	if (xml_get_sub_nodes_elements(attributes_finish, element_finish, sub_nodes_names, elements))
+	if (xml_get_sub_nodes_elements(
+			project_get_xml_index(the_project), attributes_finish, element_finish, sub_nodes_names, elements))
 	{
 		returned = interpreter_evaluate_tasks(
 					   the_project, NULL, elements, sub_nodes_names, project_help, verbose);
@@ -1306,7 +1335,8 @@ uint8_t program_get_properties(
 	while (NULL != (element = buffer_range_data(properties_elements, i++)))
 	{
 		uint8_t skip = 0;
-		const uint8_t* finish_of_attributes = xml_get_tag_finish_pos(element->start, element->finish);
+		const uint8_t* finish_of_attributes = xml_get_tag_finish_pos(
+				project_get_xml_index(the_project), element->start, element->finish);
 		buffer_release_inner_buffers(attributes);
 
 		if (!interpreter_is_xml_tag_should_be_skip_by_if_or_unless(
@@ -1349,7 +1379,8 @@ uint8_t program_get_properties(
 			property_range.start = tag;
 			property_range.finish = property_range.start + tag_length;
 
-			if (xml_get_sub_nodes_elements(element->start, element->finish, &property_range, attributes))
+			if (xml_get_sub_nodes_elements(
+					project_get_xml_index(the_project), element->start, element->finish, &property_range, attributes))
 			{
 				if (!program_get_properties(the_project, the_target, attributes, properties, 0, verbose))
 				{
@@ -1489,7 +1520,7 @@ uint8_t program_evaluate_task(
 	}
 
 	if (xml_get_sub_nodes_elements(
-			attributes_finish, element_finish,
+			project_get_xml_index(the_project), attributes_finish, element_finish,
 			&sub_node_name, inherit_all_in_a_buffer))
 	{
 		if (!program_get_properties(
@@ -57,6 +57,9 @@ const uint8_t* project_get_function_from_module(
 	const struct range* name_space, const struct range* function_name,
 	void** the_module_of_task, const uint8_t** name_space_at_module);
 
+const void* project_get_xml_index(const void* the_project);
+void* project_get_compiled_code_cache(const void* the_project);
+
 uint8_t project_get_base_directory(
 	const void* the_project, const void** the_property, uint8_t verbose);
 uint8_t project_get_buildfile_path(
@@ -23,19 +23,219 @@ struct property
 {
 	uint8_t name[UINT8_MAX + 1];
 	uint8_t value[BUFFER_SIZE_OF];
+	uint32_t hash;
 	uint8_t name_length;
 	uint8_t dynamic;
 	uint8_t read_only;
 };
 
-uint8_t buffer_append_property(void* properties, const struct property* data, ptrdiff_t data_count)
+#define PROPERTY_CHUNKS_POSITION	0
+#define PROPERTY_INDEX_POSITION		1
+#define PROPERTY_STORAGE_COUNT		(PROPERTY_INDEX_POSITION + 1)
+
+#define PROPERTY_MINIMAL_CHUNK_COUNT	16
+#define PROPERTY_MINIMAL_INDEX_COUNT	32
+
+/*Properties are stored at the chunks, each next one twice larger than
+  previous. Chunk never reallocated, so address of the property stay the same
+  while it exists. Index is an open addressing hash table with pointers
+  to the properties.*/
+
+ptrdiff_t property_get_chunk_capacity(ptrdiff_t chunk_position)
 {
-	return buffer_append(properties, (const void*)data, sizeof(struct property) * data_count);
+	return (ptrdiff_t)PROPERTY_MINIMAL_CHUNK_COUNT << chunk_position;
+}
+
+uint32_t property_get_hash(const uint8_t* name, uint8_t name_length)
+{
+	uint32_t hash = 2166136261;
+
+	for (uint8_t i = 0; i < name_length; ++i)
+	{
+		hash ^= name[i];
+		hash *= 16777619;
+	}
+
+	return hash;
+}
+
+uint8_t property_init_storage(void* properties)
+{
+	if (buffer_size(properties))
+	{
+		return 1;
+	}
+
+	return common_get_attributes_and_arguments_for_task(
+			   NULL, NULL, PROPERTY_STORAGE_COUNT, NULL, NULL, NULL, properties);
 }
 
 struct property* buffer_property_data(const void* properties, ptrdiff_t data_position)
 {
-	return (struct property*)buffer_data(properties, sizeof(struct property) * data_position);
+	ptrdiff_t i = 0;
+	const void* chunk;
+	const void* chunks = buffer_buffer_data(properties, PROPERTY_CHUNKS_POSITION);
+
+	while (NULL != (chunk = buffer_buffer_data(chunks, i++)))
+	{
+		const ptrdiff_t count = buffer_size(chunk) / sizeof(struct property);
+
+		if (data_position < count)
+		{
+			return (struct property*)buffer_data(chunk, sizeof(struct property) * data_position);
+		}
+
+		data_position -= count;
+	}
+
+	return NULL;
+}
+
+uint8_t property_index_insert(void* index, struct property* the_property)
+{
+	const ptrdiff_t capacity = buffer_size(index) / sizeof(struct property*);
+
+	if (capacity < 1)
+	{
+		return 0;
+	}
+
+	struct property** slots = (struct property**)buffer_data(index, 0);
+	const ptrdiff_t mask = capacity - 1;
+	ptrdiff_t slot = the_property->hash & mask;
+
+	while (NULL != slots[slot])
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	slots[slot] = the_property;
+	return 1;
+}
+
+uint8_t property_index_rebuild(void* properties, ptrdiff_t capacity)
+{
+	void* index = buffer_buffer_data(properties, PROPERTY_INDEX_POSITION);
+
+	if (!buffer_resize(index, 0) ||
+		!buffer_append(index, NULL, capacity * sizeof(struct property*)))
+	{
+		return 0;
+	}
+
+	memset(buffer_data(index, 0), 0, capacity * sizeof(struct property*));
+	/**/
+	ptrdiff_t i = 0;
+	const void* chunk;
+	const void* chunks = buffer_buffer_data(properties, PROPERTY_CHUNKS_POSITION);
+
+	while (NULL != (chunk = buffer_buffer_data(chunks, i++)))
+	{
+		ptrdiff_t j = 0;
+		struct property* prop;
+
+		while (NULL != (prop = (struct property*)buffer_data(chunk, sizeof(struct property) * j++)))
+		{
+			if (!property_index_insert(index, prop))
+			{
+				return 0;
+			}
+		}
+	}
+
+	return 1;
+}
+
+struct property* property_index_find(
+	const void* properties, const uint8_t* name, uint8_t name_length)
+{
+	const void* index = buffer_buffer_data(properties, PROPERTY_INDEX_POSITION);
+	const ptrdiff_t capacity = buffer_size(index) / sizeof(struct property*);
+
+	if (capacity < 1)
+	{
+		return NULL;
+	}
+
+	struct property** slots = (struct property**)buffer_data(index, 0);
+	const uint32_t hash = property_get_hash(name, name_length);
+	const ptrdiff_t mask = capacity - 1;
+	ptrdiff_t slot = hash & mask;
+	struct property* prop;
+
+	while (NULL != (prop = slots[slot]))
+	{
+		if (hash == prop->hash &&
+			name_length == prop->name_length &&
+			0 == memcmp(prop->name, name, name_length))
+		{
+			return prop;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return NULL;
+}
+
+uint8_t buffer_append_property(void* properties, const struct property* data)
+{
+	if (!property_init_storage(properties))
+	{
+		return 0;
+	}
+
+	void* chunks = buffer_buffer_data(properties, PROPERTY_CHUNKS_POSITION);
+	ptrdiff_t chunks_count = buffer_size(chunks) / buffer_size_of();
+	ptrdiff_t count = 0;
+	void* chunk = NULL;
+
+	for (ptrdiff_t i = 0; i < chunks_count; ++i)
+	{
+		chunk = buffer_buffer_data(chunks, i);
+		count += buffer_size(chunk) / sizeof(struct property);
+	}
+
+	if (NULL == chunk ||
+		property_get_chunk_capacity(chunks_count - 1) * (ptrdiff_t)sizeof(struct property) <= buffer_size(chunk))
+	{
+		uint8_t new_chunk_buffer[BUFFER_SIZE_OF];
+		chunk = (void*)new_chunk_buffer;
+
+		if (!buffer_init(chunk, BUFFER_SIZE_OF) ||
+			!buffer_append(chunk, NULL, property_get_chunk_capacity(chunks_count) * sizeof(struct property)) ||
+			!buffer_resize(chunk, 0))
+		{
+			buffer_release(chunk);
+			return 0;
+		}
+
+		if (!buffer_append_buffer(chunks, chunk, 1))
+		{
+			buffer_release(chunk);
+			return 0;
+		}
+
+		chunk = buffer_buffer_data(chunks, chunks_count++);
+	}
+
+	const ptrdiff_t size = buffer_size(chunk);
+
+	if (!buffer_append(chunk, (const void*)data, sizeof(struct property)))
+	{
+		return 0;
+	}
+
+	struct property* prop = (struct property*)buffer_data(chunk, size);
+	void* index = buffer_buffer_data(properties, PROPERTY_INDEX_POSITION);
+	const ptrdiff_t capacity = buffer_size(index) / sizeof(struct property*);
+
+	if (capacity < 2 * (count + 1))
+	{
+		return property_index_rebuild(properties, MAX(PROPERTY_MINIMAL_INDEX_COUNT, 2 * capacity));
+	}
+
+	return property_index_insert(index, prop);
 }
 
 uint8_t property_is_name_valid(const uint8_t* name, uint8_t name_length)
@@ -112,6 +312,7 @@ uint8_t property_new(
 #endif
 	the_property.name[property_name_length] = '\0';
 	the_property.name_length = property_name_length;
+	the_property.hash = property_get_hash(property_name, property_name_length);
 
 	if (!buffer_init((void*)the_property.value, BUFFER_SIZE_OF))
 	{
@@ -127,7 +328,13 @@ uint8_t property_new(
 		return 0;
 	}
 
-	return buffer_append_property(properties, &the_property, 1);
+	if (!buffer_append_property(properties, &the_property))
+	{
+		buffer_release(&the_property.value);
+		return 0;
+	}
+
+	return 1;
 }
 
 uint8_t property_get_by_pointer(const void* the_property, void* output)
@@ -160,30 +367,28 @@ uint8_t property_get_by_pointer(const void* the_property, void* output)
 uint8_t property_exists(
 	const void* properties, const uint8_t* name, uint8_t name_length, void** the_property)
 {
-	ptrdiff_t i = 0;
-	struct property* prop = NULL;
-
 	if (NULL == properties ||
-		!property_is_name_valid(name, name_length))
+		NULL == name ||
+		0 == name_length)
 	{
 		return 0;
 	}
 
-	while (NULL != (prop = buffer_property_data(properties, i++)))
+	/*NOTE: only property with valid name can be added,
+	  so there is no need to validate name on each lookup.*/
+	struct property* prop = property_index_find(properties, name, name_length);
+
+	if (NULL == prop)
 	{
-		if (name_length == prop->name_length &&
-			0 == memcmp(&prop->name, name, name_length))
-		{
-			if (the_property)
-			{
-				*the_property = prop;
-			}
+		return 0;
+	}
 
-			return 1;
-		}
+	if (the_property)
+	{
+		*the_property = prop;
 	}
 
-	return 0;
+	return 1;
 }
 
 uint8_t property_is_dynamic(const void* the_property, uint8_t* dynamic)
@@ -223,7 +428,6 @@ uint8_t property_set_by_name(
 	struct property* prop = NULL;
 
 	if (NULL == properties ||
-		!property_is_name_valid(name, name_length) ||
 		NULL == value || value_length < 0)
 	{
 		return 0;
@@ -444,12 +648,22 @@ void property_release_inner(void* properties)
 	}
 
 	ptrdiff_t i = 0;
-	struct property* prop = NULL;
+	void* chunk;
+	void* chunks = buffer_buffer_data(properties, PROPERTY_CHUNKS_POSITION);
 
-	while (NULL != (prop = buffer_property_data(properties, i++)))
+	while (NULL != (chunk = buffer_buffer_data(chunks, i++)))
 	{
-		buffer_release(&prop->value);
+		ptrdiff_t j = 0;
+		struct property* prop;
+
+		while (NULL != (prop = (struct property*)buffer_data(chunk, sizeof(struct property) * j++)))
+		{
+			buffer_release(&prop->value);
+		}
 	}
+
+	buffer_release_with_inner_buffers(chunks);
+	buffer_release_inner_buffers(properties);
 }
 
 void property_release(void* properties)
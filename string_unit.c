@@ -227,6 +227,59 @@ ptrdiff_t string_get_length(const uint8_t* input_start, const uint8_t* input_fin
 	return length;
 }
 
+uint8_t string_horspool_table(
+	const uint8_t* value_start, const uint8_t* value_finish, ptrdiff_t* shifts)
+{
+	if (range_in_parts_is_null_or_empty(value_start, value_finish) ||
+		NULL == shifts)
+	{
+		return 0;
+	}
+
+	const ptrdiff_t length = value_finish - value_start;
+
+	for (uint16_t i = 0; i < 256; ++i)
+	{
+		shifts[i] = length;
+	}
+
+	for (ptrdiff_t i = 0, count = length - 1; i < count; ++i)
+	{
+		shifts[value_start[i]] = count - i;
+	}
+
+	return 1;
+}
+
+const uint8_t* string_horspool_find(
+	const uint8_t* input_start, const uint8_t* input_finish,
+	const uint8_t* value_start, const uint8_t* value_finish, const ptrdiff_t* shifts)
+{
+	const ptrdiff_t length = value_finish - value_start;
+
+	if (1 == length)
+	{
+		return (const uint8_t*)memchr(input_start, *value_start, input_finish - input_start);
+	}
+
+	const uint8_t last = value_start[length - 1];
+
+	while (length <= input_finish - input_start)
+	{
+		const uint8_t symbol = input_start[length - 1];
+
+		if (last == symbol &&
+			0 == memcmp(input_start, value_start, length - 1))
+		{
+			return input_start;
+		}
+
+		input_start += shifts[symbol];
+	}
+
+	return NULL;
+}
+
 ptrdiff_t string_index_of(const uint8_t* input_start, const uint8_t* input_finish,
 						  const uint8_t* value_start, const uint8_t* value_finish)
 {
@@ -31,6 +31,11 @@ const uint8_t* string_find_any_symbol_like_or_not_like_that(
 	uint8_t like, int8_t step);
 ptrdiff_t string_get_length(
 	const uint8_t* input_start, const uint8_t* input_finish);
+uint8_t string_horspool_table(
+	const uint8_t* value_start, const uint8_t* value_finish, ptrdiff_t* shifts);
+const uint8_t* string_horspool_find(
+	const uint8_t* input_start, const uint8_t* input_finish,
+	const uint8_t* value_start, const uint8_t* value_finish, const ptrdiff_t* shifts);
 ptrdiff_t string_index_of(
 	const uint8_t* input_start, const uint8_t* input_finish,
 	const uint8_t* value_start, const uint8_t* value_finish);
@@ -19,11 +19,13 @@
 #include "range.h"
 #include "string_unit.h"
 #include "text_encoding.h"
+#include "thread.h"
 #include "xml.h"
 
 #include <string.h>
 
 static const uint8_t depends_delimiter = ',';
+static uint8_t is_parallel_evaluation = 0;
 
 struct target
 {
@@ -47,6 +49,26 @@ struct target* buffer_target_data(const void* targets, ptrdiff_t data_position)
 	return (struct target*)buffer_data(targets, sizeof(struct target) * data_position);
 }
 
+struct target_scheduler
+{
+	uint8_t nodes[BUFFER_SIZE_OF];
+	uint8_t states[BUFFER_SIZE_OF];
+	uint8_t pending[BUFFER_SIZE_OF];
+	uint8_t edges[BUFFER_SIZE_OF];
+	uint8_t ready[BUFFER_SIZE_OF];
+	uint8_t stack[BUFFER_SIZE_OF];
+	uint8_t mutex[BUFFER_SIZE_OF];
+	uint8_t condition[BUFFER_SIZE_OF];
+	void* the_project;
+	ptrdiff_t ready_position;
+	ptrdiff_t finished;
+	uint8_t failed;
+	uint8_t verbose;
+};
+
+#define TARGET_SCHEDULER_VISITING	0
+#define TARGET_SCHEDULER_VISITED	1
+
 uint8_t target_exists(
 	const void* targets,
 	const uint8_t* name_start, const uint8_t* name_finish, uint8_t verbose)
@@ -130,8 +152,9 @@ uint8_t target_print_description(
 	sub_node_name.start = description_str;
 	sub_node_name.finish = sub_node_name.start + 12;
 
-	if (!xml_get_sub_nodes_elements(attributes_finish, element_finish, &sub_node_name,
-									(void*)(&the_target->tasks)))
+	if (!xml_get_sub_nodes_elements(
+			project_get_xml_index(the_project), attributes_finish, element_finish, &sub_node_name,
+			(void*)(&the_target->tasks)))
 	{
 		return echo(0, Default, NULL, Info, n, 1, 0, verbose);
 	}
@@ -282,7 +305,8 @@ uint8_t target_new(
 	}
 	else
 	{
-		if (!xml_get_sub_nodes_elements(attributes_finish, element_finish, NULL, (void*)(&the_target->tasks)))
+		if (!xml_get_sub_nodes_elements(
+				project_get_xml_index(the_project), attributes_finish, element_finish, NULL, (void*)(&the_target->tasks)))
 		{
 			if (!buffer_resize((void*)(&the_target->tasks), 0))
 			{
@@ -469,7 +493,7 @@ uint8_t target_evaluate(
 	uint8_t tmp_buffer[BUFFER_SIZE_OF];
 	void* tmp = (void*)tmp_buffer;
 
-	if (!buffer_init(tmp, BUFFER_SIZE_OF))
+	if (!buffer_init_at_arena(tmp, BUFFER_SIZE_OF))
 	{
 		return 0;
 	}
@@ -504,6 +528,203 @@ uint8_t target_evaluate(
 	return skip;
 }
 
+ptrdiff_t target_scheduler_get_node(
+	const struct target_scheduler* scheduler, const void* the_target)
+{
+	ptrdiff_t index = 0;
+	const void** node;
+
+	while (NULL != (node = (const void**)buffer_data(scheduler->nodes, index * sizeof(void*))))
+	{
+		if (the_target == *node)
+		{
+			return index;
+		}
+
+		++index;
+	}
+
+	return -1;
+}
+
+ptrdiff_t target_scheduler_add_node(struct target_scheduler* scheduler, void* the_target)
+{
+	ptrdiff_t index = target_scheduler_get_node(scheduler, the_target);
+
+	if (-1 < index)
+	{
+		return TARGET_SCHEDULER_VISITING == *buffer_uint8_t_data(scheduler->states, index) ? -1 : index;
+	}
+
+	index = buffer_size(scheduler->states);
+
+	if (!buffer_append(scheduler->nodes, (const uint8_t*)&the_target, sizeof(void*)) ||
+		!buffer_push_back(scheduler->states, TARGET_SCHEDULER_VISITING) ||
+		!buffer_append(scheduler->pending, NULL, sizeof(ptrdiff_t)))
+	{
+		return -1;
+	}
+
+	ptrdiff_t pending = 0;
+	ptrdiff_t depend_index = 0;
+	const struct range* depend;
+
+	while (NULL != (depend = target_get_depend(the_target, depend_index++)))
+	{
+		void* target_dep;
+
+		if (!project_target_get(scheduler->the_project, depend->start, depend->finish, &target_dep,
+								scheduler->verbose) ||
+			the_target == target_dep)
+		{
+			return -1;
+		}
+
+		const ptrdiff_t edge[2] = { target_scheduler_add_node(scheduler, target_dep), index };
+
+		if (edge[0] < 0 ||
+			!buffer_append(scheduler->edges, (const uint8_t*)edge, sizeof(edge)))
+		{
+			return -1;
+		}
+
+		++pending;
+	}
+
+	*((ptrdiff_t*)buffer_data(scheduler->pending, index * sizeof(ptrdiff_t))) = pending;
+	*buffer_uint8_t_data(scheduler->states, index) = TARGET_SCHEDULER_VISITED;
+
+	if (!pending &&
+		!buffer_append(scheduler->ready, (const uint8_t*)&index, sizeof(ptrdiff_t)))
+	{
+		return -1;
+	}
+
+	return index;
+}
+
+uint8_t target_scheduler_node_finished(struct target_scheduler* scheduler, ptrdiff_t index)
+{
+	ptrdiff_t i = 0;
+	const ptrdiff_t* edge;
+
+	while (NULL != (edge = (const ptrdiff_t*)buffer_data(scheduler->edges, i)))
+	{
+		i += 2 * sizeof(ptrdiff_t);
+
+		if (index != edge[0])
+		{
+			continue;
+		}
+
+		ptrdiff_t* pending = (ptrdiff_t*)buffer_data(scheduler->pending, edge[1] * sizeof(ptrdiff_t));
+
+		if (0 == --(*pending) &&
+			!buffer_append(scheduler->ready, (const uint8_t*)&edge[1], sizeof(ptrdiff_t)))
+		{
+			return 0;
+		}
+	}
+
+	++scheduler->finished;
+	return 1;
+}
+
+uint8_t target_scheduler_worker(void* argument)
+{
+	struct target_scheduler* scheduler = (struct target_scheduler*)argument;
+	const ptrdiff_t count = buffer_size(scheduler->states);
+	/**/
+	thread_mutex_lock(scheduler->mutex);
+
+	while (!scheduler->failed && scheduler->finished < count)
+	{
+		const ptrdiff_t* index = (const ptrdiff_t*)buffer_data(
+									 scheduler->ready, scheduler->ready_position);
+
+		if (NULL == index)
+		{
+			if (!thread_condition_wait(scheduler->condition, scheduler->mutex))
+			{
+				scheduler->failed = 1;
+			}
+
+			continue;
+		}
+
+		scheduler->ready_position += sizeof(ptrdiff_t);
+		const ptrdiff_t node = *index;
+		void* the_target = *((void**)buffer_data(scheduler->nodes, node * sizeof(void*)));
+
+		if (!target_evaluate(scheduler->the_project, the_target, scheduler->stack, 0, scheduler->verbose) ||
+			!target_scheduler_node_finished(scheduler, node))
+		{
+			scheduler->failed = 1;
+		}
+
+		thread_condition_notify_all(scheduler->condition);
+	}
+
+	thread_mutex_unlock(scheduler->mutex);
+	return !scheduler->failed;
+}
+
+void target_scheduler_release(struct target_scheduler* scheduler)
+{
+	buffer_release(scheduler->nodes);
+	buffer_release(scheduler->states);
+	buffer_release(scheduler->pending);
+	buffer_release(scheduler->edges);
+	buffer_release(scheduler->ready);
+	buffer_release(scheduler->stack);
+	thread_condition_release(scheduler->condition);
+	thread_mutex_release(scheduler->mutex);
+}
+
+uint8_t target_evaluate_parallel(
+	void* the_project, void* the_target, uint16_t jobs, uint8_t verbose)
+{
+	struct target_scheduler scheduler;
+
+	if (!buffer_init(scheduler.nodes, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.states, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.pending, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.edges, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.ready, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.stack, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.mutex, BUFFER_SIZE_OF) ||
+		!buffer_init(scheduler.condition, BUFFER_SIZE_OF))
+	{
+		return 0;
+	}
+
+	scheduler.the_project = the_project;
+	scheduler.ready_position = 0;
+	scheduler.finished = 0;
+	scheduler.failed = 0;
+	scheduler.verbose = verbose;
+
+	if (target_scheduler_add_node(&scheduler, the_target) < 0 ||
+		!thread_mutex_init(scheduler.mutex) ||
+		!thread_condition_init(scheduler.condition))
+	{
+		target_scheduler_release(&scheduler);
+		return 0;
+	}
+
+	const ptrdiff_t count = buffer_size(scheduler.states);
+	jobs = (uint16_t)MIN(jobs, count);
+	/**/
+	is_parallel_evaluation = 1;
+	thread_set_interpreter_lock(scheduler.mutex);
+	const uint8_t returned = thread_run(jobs, target_scheduler_worker, &scheduler);
+	thread_set_interpreter_lock(NULL);
+	is_parallel_evaluation = 0;
+	/**/
+	target_scheduler_release(&scheduler);
+	return returned && count == scheduler.finished;
+}
+
 uint8_t target_evaluate_by_name(
 	void* the_project,
 	const uint8_t* name_start, const uint8_t* name_finish,
@@ -532,6 +753,15 @@ uint8_t target_evaluate_by_name(
 		}
 	}
 
+	const uint16_t jobs = common_get_jobs();
+
+	if (1 < jobs &&
+		!is_parallel_evaluation &&
+		NULL != target_get_depend(the_target, 0))
+	{
+		return target_evaluate_parallel(the_project, the_target, jobs, verbose);
+	}
+
 	uint8_t stack_buffer[BUFFER_SIZE_OF];
 	void* stack = (void*)stack_buffer;
 
@@ -0,0 +1,272 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2022 TheVice
+ *
+ */
+
+#include "thread.h"
+#include "buffer.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+struct thread_context
+{
+	uint8_t(*routine)(void*);
+	void* argument;
+#if defined(_WIN32)
+	HANDLE thread;
+#else
+	pthread_t thread;
+#endif
+	ptrdiff_t pool_hits;
+	ptrdiff_t pool_misses;
+	uint8_t result;
+	uint8_t is_started;
+};
+
+static void* interpreter_lock = NULL;
+
+#if defined(_WIN32)
+#define MUTEX_TYPE		CRITICAL_SECTION
+#define CONDITION_TYPE	CONDITION_VARIABLE
+#else
+#define MUTEX_TYPE		pthread_mutex_t
+#define CONDITION_TYPE	pthread_cond_t
+#endif
+
+uint8_t thread_mutex_init(void* the_mutex)
+{
+	if (!buffer_resize(the_mutex, 0) ||
+		!buffer_append(the_mutex, NULL, sizeof(MUTEX_TYPE)))
+	{
+		return 0;
+	}
+
+	MUTEX_TYPE* mutex = (MUTEX_TYPE*)buffer_data(the_mutex, 0);
+#if defined(_WIN32)
+	InitializeCriticalSection(mutex);
+	return 1;
+#else
+	return 0 == pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+void thread_mutex_lock(void* the_mutex)
+{
+	MUTEX_TYPE* mutex = (MUTEX_TYPE*)buffer_data(the_mutex, 0);
+
+	if (NULL == mutex)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	EnterCriticalSection(mutex);
+#else
+	pthread_mutex_lock(mutex);
+#endif
+}
+
+void thread_mutex_unlock(void* the_mutex)
+{
+	MUTEX_TYPE* mutex = (MUTEX_TYPE*)buffer_data(the_mutex, 0);
+
+	if (NULL == mutex)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	LeaveCriticalSection(mutex);
+#else
+	pthread_mutex_unlock(mutex);
+#endif
+}
+
+void thread_mutex_release(void* the_mutex)
+{
+	MUTEX_TYPE* mutex = (MUTEX_TYPE*)buffer_data(the_mutex, 0);
+
+	if (NULL != mutex)
+	{
+#if defined(_WIN32)
+		DeleteCriticalSection(mutex);
+#else
+		pthread_mutex_destroy(mutex);
+#endif
+	}
+
+	buffer_release(the_mutex);
+}
+
+uint8_t thread_condition_init(void* the_condition)
+{
+	if (!buffer_resize(the_condition, 0) ||
+		!buffer_append(the_condition, NULL, sizeof(CONDITION_TYPE)))
+	{
+		return 0;
+	}
+
+	CONDITION_TYPE* condition = (CONDITION_TYPE*)buffer_data(the_condition, 0);
+#if defined(_WIN32)
+	InitializeConditionVariable(condition);
+	return 1;
+#else
+	return 0 == pthread_cond_init(condition, NULL);
+#endif
+}
+
+uint8_t thread_condition_wait(void* the_condition, void* the_mutex)
+{
+	CONDITION_TYPE* condition = (CONDITION_TYPE*)buffer_data(the_condition, 0);
+	MUTEX_TYPE* mutex = (MUTEX_TYPE*)buffer_data(the_mutex, 0);
+
+	if (NULL == condition ||
+		NULL == mutex)
+	{
+		return 0;
+	}
+
+#if defined(_WIN32)
+	return 0 != SleepConditionVariableCS(condition, mutex, INFINITE);
+#else
+	return 0 == pthread_cond_wait(condition, mutex);
+#endif
+}
+
+void thread_condition_notify_all(void* the_condition)
+{
+	CONDITION_TYPE* condition = (CONDITION_TYPE*)buffer_data(the_condition, 0);
+
+	if (NULL == condition)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	WakeAllConditionVariable(condition);
+#else
+	pthread_cond_broadcast(condition);
+#endif
+}
+
+void thread_condition_release(void* the_condition)
+{
+#if !defined(_WIN32)
+	CONDITION_TYPE* condition = (CONDITION_TYPE*)buffer_data(the_condition, 0);
+
+	if (NULL != condition)
+	{
+		pthread_cond_destroy(condition);
+	}
+
+#endif
+	buffer_release(the_condition);
+}
+
+#if defined(_WIN32)
+DWORD WINAPI thread_routine(LPVOID argument)
+#else
+void* thread_routine(void* argument)
+#endif
+{
+	struct thread_context* context = (struct thread_context*)argument;
+	context->result = context->routine(context->argument);
+	buffer_release_pool();
+	buffer_get_pool_statistics(&context->pool_hits, &context->pool_misses);
+	buffer_arena_release();
+#if defined(_WIN32)
+	return 0;
+#else
+	return NULL;
+#endif
+}
+
+uint8_t thread_run(uint16_t count, uint8_t(*routine)(void*), void* argument)
+{
+	if (NULL == routine)
+	{
+		return 0;
+	}
+
+	if (count < 2)
+	{
+		return routine(argument);
+	}
+
+	uint8_t contexts_buffer[BUFFER_SIZE_OF];
+	void* contexts = (void*)contexts_buffer;
+
+	if (!buffer_init(contexts, BUFFER_SIZE_OF) ||
+		!buffer_append(contexts, NULL, count * sizeof(struct thread_context)))
+	{
+		buffer_release(contexts);
+		return 0;
+	}
+
+	struct thread_context* context = (struct thread_context*)buffer_data(contexts, 0);
+
+	for (uint16_t i = 1; i < count; ++i)
+	{
+		context[i].routine = routine;
+		context[i].argument = argument;
+		context[i].pool_hits = 0;
+		context[i].pool_misses = 0;
+		context[i].result = 0;
+#if defined(_WIN32)
+		context[i].thread = CreateThread(NULL, 0, thread_routine, &context[i], 0, NULL);
+		context[i].is_started = NULL != context[i].thread;
+#else
+		context[i].is_started = 0 == pthread_create(&context[i].thread, NULL, thread_routine, &context[i]);
+#endif
+	}
+
+	uint8_t result = routine(argument);
+
+	for (uint16_t i = 1; i < count; ++i)
+	{
+		if (!context[i].is_started)
+		{
+			continue;
+		}
+
+#if defined(_WIN32)
+		WaitForSingleObject(context[i].thread, INFINITE);
+		CloseHandle(context[i].thread);
+#else
+		pthread_join(context[i].thread, NULL);
+#endif
+		/*NOTE: counters of the finished thread are added to the joining one, so they reach the main thread.*/
+		buffer_add_pool_statistics(context[i].pool_hits, context[i].pool_misses);
+		result = result && context[i].result;
+	}
+
+	buffer_release(contexts);
+	return result;
+}
+
+void thread_set_interpreter_lock(void* the_mutex)
+{
+	interpreter_lock = the_mutex;
+}
+
+void thread_enter_interpreter()
+{
+	if (NULL != interpreter_lock)
+	{
+		thread_mutex_lock(interpreter_lock);
+	}
+}
+
+void thread_leave_interpreter()
+{
+	if (NULL != interpreter_lock)
+	{
+		thread_mutex_unlock(interpreter_lock);
+	}
+}
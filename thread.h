@@ -0,0 +1,29 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2022 TheVice
+ *
+ */
+
+#ifndef _THREAD_H_
+#define _THREAD_H_
+
+#include <stdint.h>
+
+uint8_t thread_mutex_init(void* the_mutex);
+void thread_mutex_lock(void* the_mutex);
+void thread_mutex_unlock(void* the_mutex);
+void thread_mutex_release(void* the_mutex);
+
+uint8_t thread_condition_init(void* the_condition);
+uint8_t thread_condition_wait(void* the_condition, void* the_mutex);
+void thread_condition_notify_all(void* the_condition);
+void thread_condition_release(void* the_condition);
+
+uint8_t thread_run(uint16_t count, uint8_t(*routine)(void*), void* argument);
+
+void thread_set_interpreter_lock(void* the_mutex);
+void thread_enter_interpreter();
+void thread_leave_interpreter();
+
+#endif
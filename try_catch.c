@@ -151,7 +151,8 @@ uint8_t try_catch_evaluate_task(
 
 		sub_nodes_name.finish = sub_nodes_name.start + tags_lengths[i];
 
-		if (!xml_get_sub_nodes_elements(attributes_finish, element_finish, &sub_nodes_name, elements))
+		if (!xml_get_sub_nodes_elements(
+				project_get_xml_index(the_project), attributes_finish, element_finish, &sub_nodes_name, elements))
 		{
 			if (!i)
 			{
@@ -177,7 +178,8 @@ uint8_t try_catch_evaluate_task(
 
 		while (NULL != (element = buffer_range_data(elements, index++)))
 		{
-			if (xml_get_sub_nodes_elements(element->start, element->finish, NULL, sub_elements) && 1 == i)
+			if (xml_get_sub_nodes_elements(
+					project_get_xml_index(the_project), element->start, element->finish, NULL, sub_elements) && 1 == i)
 			{
 				if (!buffer_resize(tmp, 0))
 				{
@@ -188,8 +190,9 @@ uint8_t try_catch_evaluate_task(
 				static const uint8_t* property_str = (const uint8_t*)"property";
 				static const uint8_t property_str_length = 8;
 
-				if (xml_get_attribute_value(element->start, element->finish,
-											property_str, property_str_length, tmp))
+				if (xml_get_attribute_value(
+						project_get_xml_index(the_project), element->start, element->finish,
+						property_str, property_str_length, tmp))
 				{
 					void* the_property = NULL;
 					const uint8_t* property_name = buffer_uint8_t_data(tmp, 0);
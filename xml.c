@@ -42,6 +42,34 @@ static const uint8_t cdata_finish_length = 3;
 #define AMPERSAND_POSITION	2
 #define QUOTE_POSITION		4
 
+struct xml_element
+{
+	const uint8_t* start;
+	const uint8_t* name_finish;
+	const uint8_t* tag_finish;
+	const uint8_t* finish;
+	ptrdiff_t children_position;
+	ptrdiff_t children_count;
+	ptrdiff_t attributes_position;
+	ptrdiff_t attributes_count;
+};
+
+struct xml_attribute
+{
+	struct range key;
+	struct range value;
+	uint8_t status;
+};
+
+#define XML_INDEX_ELEMENTS_POSITION		0
+#define XML_INDEX_CHILDREN_POSITION		1
+#define XML_INDEX_ATTRIBUTES_POSITION	2
+#define XML_INDEX_COUNT_OF_POSITIONS	(XML_INDEX_ATTRIBUTES_POSITION + 1)
+
+#define XML_ATTRIBUTE_NOT_VALID		0
+#define XML_ATTRIBUTE_EMPTY			1
+#define XML_ATTRIBUTE_WITH_VALUE	2
+
 const uint8_t* xml_skip_comment(const uint8_t* start, const uint8_t* finish)
 {
 	static const uint8_t* comment_start = (const uint8_t*)"<!--";
@@ -104,14 +132,26 @@ const uint8_t* xml_skip_comment(const uint8_t* start, const uint8_t* finish)
 	return start;
 }
 
+const struct xml_element* xml_index_get_element(const void* the_index, const uint8_t* start);
+
 const uint8_t* xml_get_tag_finish_pos(
-	const uint8_t* start, const uint8_t* finish)
+	const void* the_index, const uint8_t* start, const uint8_t* finish)
 {
 	if (range_in_parts_is_null_or_empty(start, finish))
 	{
 		return finish;
 	}
 
+	const struct xml_element* element = xml_index_get_element(the_index, start);
+
+	if (NULL != element &&
+		NULL != element->tag_finish &&
+		start == element->name_finish &&
+		finish == element->finish)
+	{
+		return element->tag_finish;
+	}
+
 	while (NULL != start && start < finish)
 	{
 		uint32_t char_set;
@@ -150,7 +190,31 @@ const uint8_t* xml_get_tag_finish_pos(
 	return start;
 }
 
-uint16_t xml_get_sub_nodes_elements(
+uint8_t xml_is_element_in_the_list(
+	const struct range* element, const struct range* sub_nodes_names)
+{
+	static const uint8_t zero = '\0';
+	const uint8_t* tag_name_finish = xml_get_tag_name(element->start, element->finish);
+	const uint8_t* sub_node_name_start = sub_nodes_names->start;
+	const uint8_t* sub_node_name_finish = sub_nodes_names->start;
+
+	while (sub_nodes_names->finish != (sub_node_name_finish = string_find_any_symbol_like_or_not_like_that(
+										   sub_node_name_finish, sub_nodes_names->finish, &zero, &zero + 1, 1, 1)))
+	{
+		if (string_equal(element->start, tag_name_finish, sub_node_name_start, sub_node_name_finish))
+		{
+			return 1;
+		}
+
+		sub_node_name_finish = string_find_any_symbol_like_or_not_like_that(
+								   sub_node_name_finish, sub_nodes_names->finish, &zero, &zero + 1, 0, 1);
+		sub_node_name_start = sub_node_name_finish;
+	}
+
+	return 0;
+}
+
+uint16_t xml_scan_sub_nodes_elements(
 	const uint8_t* start, const uint8_t* finish,
 	const struct range* sub_nodes_names, void* elements)
 {
@@ -176,7 +240,7 @@ uint16_t xml_get_sub_nodes_elements(
 		}
 
 		start = string_enumerate(start, finish, NULL);
-		const uint8_t* tag_finish_pos = xml_get_tag_finish_pos(start, finish);
+		const uint8_t* tag_finish_pos = xml_get_tag_finish_pos(NULL, start, finish);
 
 		if (!tag_finish_pos)
 		{
@@ -255,27 +319,7 @@ uint16_t xml_get_sub_nodes_elements(
 
 			if (!range_is_null_or_empty(sub_nodes_names))
 			{
-				uint8_t found = 0;
-				static const uint8_t zero = '\0';
-				const uint8_t* tag_name_finish = xml_get_tag_name(element->start, element->finish);
-				const uint8_t* sub_node_name_start = sub_nodes_names->start;
-				const uint8_t* sub_node_name_finish = sub_nodes_names->start;
-
-				while (sub_nodes_names->finish != (sub_node_name_finish = string_find_any_symbol_like_or_not_like_that(
-													   sub_node_name_finish, sub_nodes_names->finish, &zero, &zero + 1, 1, 1)))
-				{
-					if (string_equal(element->start, tag_name_finish, sub_node_name_start, sub_node_name_finish))
-					{
-						found = 1;
-						break;
-					}
-
-					sub_node_name_finish = string_find_any_symbol_like_or_not_like_that(
-											   sub_node_name_finish, sub_nodes_names->finish, &zero, &zero + 1, 0, 1);
-					sub_node_name_start = sub_node_name_finish;
-				}
-
-				if (!found)
+				if (!xml_is_element_in_the_list(element, sub_nodes_names))
 				{
 					if (!buffer_resize(elements, buffer_size(elements) - sizeof(struct range)))
 					{
@@ -293,6 +337,89 @@ uint16_t xml_get_sub_nodes_elements(
 	return 0 == depth ? count : 0;
 }
 
+const struct xml_element* xml_index_get_element(const void* the_index, const uint8_t* start)
+{
+	const void* elements = buffer_buffer_data(the_index, XML_INDEX_ELEMENTS_POSITION);
+	const struct xml_element* element = (const struct xml_element*)buffer_data(elements, 0);
+
+	/*NOTE: first element is the root, that cover all indexed content.*/
+	if (NULL == element ||
+		start < element->start ||
+		element->finish <= start)
+	{
+		return NULL;
+	}
+
+	ptrdiff_t low = 0;
+	ptrdiff_t high = buffer_size(elements) / sizeof(struct xml_element) - 1;
+
+	while (low < high)
+	{
+		const ptrdiff_t middle = low + (high - low + 1) / 2;
+
+		if (element[middle].start <= start)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	return &element[low];
+}
+
+uint16_t xml_get_sub_nodes_elements(
+	const void* the_index, const uint8_t* start, const uint8_t* finish,
+	const struct range* sub_nodes_names, void* elements)
+{
+	if (range_in_parts_is_null_or_empty(start, finish) ||
+		NULL == elements)
+	{
+		return 0;
+	}
+
+	const struct xml_element* element = xml_index_get_element(the_index, start);
+
+	if (NULL == element ||
+		(start != element->start && start != element->tag_finish) ||
+		finish != element->finish ||
+		element->children_count < 0)
+	{
+		return xml_scan_sub_nodes_elements(start, finish, sub_nodes_names, elements);
+	}
+
+	const void* children = buffer_buffer_data(the_index, XML_INDEX_CHILDREN_POSITION);
+	const struct range* child = buffer_range_data(children, element->children_position);
+
+	if (range_is_null_or_empty(sub_nodes_names))
+	{
+		return (0 < element->children_count &&
+				buffer_append_range(elements, child, element->children_count)) ?
+			   (uint16_t)element->children_count : 0;
+	}
+
+	uint16_t count = 0;
+
+	for (ptrdiff_t i = 0; i < element->children_count; ++i)
+	{
+		if (!xml_is_element_in_the_list(&child[i], sub_nodes_names))
+		{
+			continue;
+		}
+
+		if (!buffer_append_range(elements, &child[i], 1))
+		{
+			return 0;
+		}
+
+		++count;
+	}
+
+	return count;
+}
+
 const uint8_t* xml_get_tag_name(const uint8_t* start, const uint8_t* finish)
 {
 	static const uint8_t tab_space_close_tag[] = { '\t', ' ', '/', '>', '\r', '\n' };
@@ -445,13 +572,97 @@ uint8_t xml_read_ampersand_based_data(
 	return pos < finish ? buffer_append(output, pos, finish - pos) : 1;
 }
 
-uint8_t xml_get_attribute_value(
+const uint8_t* xml_get_attribute_key(
 	const uint8_t* start, const uint8_t* finish,
-	const uint8_t* attribute, ptrdiff_t attribute_length,
-	void* value)
+	const uint8_t* pos, struct range* key)
 {
 	static const uint8_t* equal_space_tab = (const uint8_t*)"= \t";
 
+	if (finish == (pos = (string_find_any_symbol_like_or_not_like_that(
+							  pos, finish,
+							  equal_space_tab, equal_space_tab + 1,
+							  1, 1))))
+	{
+		return NULL;
+	}
+
+	const uint8_t* space_tab = equal_space_tab + 1;
+	/**/
+	key->finish =
+		string_find_any_symbol_like_or_not_like_that(
+			pos, start, equal_space_tab, equal_space_tab + 3, 0, -1);
+	key->start =
+		string_find_any_symbol_like_or_not_like_that(
+			key->finish, start, space_tab, space_tab + 2, 1, -1);
+	/**/
+	key->start =
+		string_find_any_symbol_like_or_not_like_that(
+			key->start, key->finish, space_tab, space_tab + 2, 0, 1);
+	key->finish =
+		string_find_any_symbol_like_or_not_like_that(
+			key->finish, pos, equal_space_tab, equal_space_tab + 3, 1, 1);
+	/**/
+	return string_enumerate(pos, finish, NULL);
+}
+
+uint8_t xml_get_attribute_value_range(
+	const uint8_t* pos, const uint8_t* finish, struct range* value)
+{
+	static const uint8_t* double_quote = (const uint8_t*)"\"\"";
+	static const uint8_t* that = &characters[QUOTE_POSITION];
+	pos = string_find_any_symbol_like_or_not_like_that(
+			  pos, finish, that, that + 1, 1, 1);
+
+	if (finish != pos &&
+		string_starts_with(pos, finish, double_quote, double_quote + 2))
+	{
+		return XML_ATTRIBUTE_EMPTY;
+	}
+
+	pos = string_enumerate(pos, finish, NULL);
+	pos = string_find_any_symbol_like_or_not_like_that(
+			  pos, finish, that, that + 1, 0, 1);
+
+	if (finish == pos)
+	{
+		return XML_ATTRIBUTE_NOT_VALID;
+	}
+
+	value->start = pos;
+	value->finish = string_enumerate(pos, finish, NULL);
+	value->finish = string_find_any_symbol_like_or_not_like_that(
+						value->finish, finish, that, that + 1, 1, 1);
+
+	if (finish == value->finish &&
+		characters[QUOTE_POSITION] != *value->finish)
+	{
+		return XML_ATTRIBUTE_NOT_VALID;
+	}
+
+	return XML_ATTRIBUTE_WITH_VALUE;
+}
+
+uint8_t xml_get_attribute_value_from_range(
+	uint8_t status, const struct range* attribute_value, void* value)
+{
+	if (XML_ATTRIBUTE_WITH_VALUE != status)
+	{
+		return XML_ATTRIBUTE_EMPTY == status;
+	}
+
+	if (NULL == value)
+	{
+		return 1;
+	}
+
+	return xml_read_ampersand_based_data(attribute_value->start, attribute_value->finish, value);
+}
+
+uint8_t xml_get_attribute_value(
+	const void* the_index, const uint8_t* start, const uint8_t* finish,
+	const uint8_t* attribute, ptrdiff_t attribute_length,
+	void* value)
+{
 	if (range_in_parts_is_null_or_empty(start, finish) ||
 		NULL == attribute ||
 		0 == attribute_length ||
@@ -460,74 +671,49 @@ uint8_t xml_get_attribute_value(
 		return 0;
 	}
 
-	const uint8_t* pos = start;
+	const struct xml_element* element = xml_index_get_element(the_index, start);
 
-	while (finish != (pos = (string_find_any_symbol_like_or_not_like_that(
-								 pos, finish,
-								 equal_space_tab, equal_space_tab + 1,
-								 1, 1))))
+	if (NULL != element &&
+		start == element->name_finish &&
+		finish == element->tag_finish)
 	{
-		static const uint8_t* double_quote = (const uint8_t*)"\"\"";
-		const uint8_t* space_tab = equal_space_tab + 1;
-		/**/
-		const uint8_t* key_finish =
-			string_find_any_symbol_like_or_not_like_that(
-				pos, start, equal_space_tab, equal_space_tab + 3, 0, -1);
-		const uint8_t* key_start =
-			string_find_any_symbol_like_or_not_like_that(
-				key_finish, start, space_tab, space_tab + 2, 1, -1);
-		/**/
-		key_start =
-			string_find_any_symbol_like_or_not_like_that(
-				key_start, key_finish, space_tab, space_tab + 2, 0, 1);
-		key_finish =
-			string_find_any_symbol_like_or_not_like_that(
-				key_finish, pos, equal_space_tab, equal_space_tab + 3, 1, 1);
-		/**/
-		pos = string_enumerate(pos, finish, NULL);
+		const void* attributes = buffer_buffer_data(the_index, XML_INDEX_ATTRIBUTES_POSITION);
+		const struct xml_attribute* the_attribute =
+			(const struct xml_attribute*)buffer_data(
+				attributes, sizeof(struct xml_attribute) * element->attributes_position);
 
-		if (!string_equal(
-				key_start, key_finish,
-				attribute, attribute + attribute_length))
+		for (ptrdiff_t i = 0; i < element->attributes_count; ++i)
 		{
-			continue;
+			if (string_equal(
+					the_attribute[i].key.start, the_attribute[i].key.finish,
+					attribute, attribute + attribute_length))
+			{
+				return xml_get_attribute_value_from_range(
+						   the_attribute[i].status, &the_attribute[i].value, value);
+			}
 		}
 
-		static const uint8_t* that = &characters[QUOTE_POSITION];
-		pos = string_find_any_symbol_like_or_not_like_that(
-				  pos, finish, that, that + 1, 1, 1);
+		return 0;
+	}
 
-		if (finish != pos &&
-			string_starts_with(pos, finish, double_quote, double_quote + 2))
-		{
-			return 1;
-		}
+	struct range key;
 
-		pos = string_enumerate(pos, finish, NULL);
-		pos = string_find_any_symbol_like_or_not_like_that(
-				  pos, finish, that, that + 1, 0, 1);
+	const uint8_t* pos = start;
 
-		if (finish == pos)
+	while (NULL != (pos = xml_get_attribute_key(start, finish, pos, &key)))
+	{
+		if (!string_equal(
+				key.start, key.finish,
+				attribute, attribute + attribute_length))
 		{
-			return 0;
+			continue;
 		}
 
-		key_finish = string_enumerate(pos, finish, NULL);
-		key_finish = string_find_any_symbol_like_or_not_like_that(
-						 key_finish, finish, that, that + 1, 1, 1);
-
-		if (finish == key_finish &&
-			characters[QUOTE_POSITION] != *key_finish)
-		{
-			return 0;
-		}
+		struct range attribute_value;
 
-		if (NULL == value)
-		{
-			return 1;
-		}
+		const uint8_t status = xml_get_attribute_value_range(pos, finish, &attribute_value);
 
-		return xml_read_ampersand_based_data(pos, key_finish, value);
+		return xml_get_attribute_value_from_range(status, &attribute_value, value);
 	}
 
 	return 0;
@@ -649,3 +835,123 @@ uint8_t xml_get_element_value(
 
 	return 1;
 }
+
+uint8_t xml_index_add_element(
+	void* index, const uint8_t* start, const uint8_t* finish, uint8_t is_root)
+{
+	void* elements = buffer_buffer_data(index, XML_INDEX_ELEMENTS_POSITION);
+	void* children = buffer_buffer_data(index, XML_INDEX_CHILDREN_POSITION);
+	void* attributes = buffer_buffer_data(index, XML_INDEX_ATTRIBUTES_POSITION);
+	/**/
+	struct xml_element element;
+	element.start = start;
+	element.finish = finish;
+	element.attributes_position = buffer_size(attributes) / sizeof(struct xml_attribute);
+	element.attributes_count = 0;
+
+	if (is_root)
+	{
+		element.name_finish = NULL;
+		element.tag_finish = NULL;
+	}
+	else
+	{
+		element.name_finish = xml_get_tag_name(start, finish);
+		element.tag_finish = xml_get_tag_finish_pos(NULL, element.name_finish, finish);
+		start = element.tag_finish;
+	}
+
+	if (!range_in_parts_is_null_or_empty(element.name_finish, element.tag_finish))
+	{
+		struct xml_attribute attribute;
+		const uint8_t* pos = element.name_finish;
+
+		while (NULL != (pos = xml_get_attribute_key(element.name_finish, element.tag_finish, pos, &attribute.key)))
+		{
+			attribute.status = xml_get_attribute_value_range(pos, element.tag_finish, &attribute.value);
+
+			if (!buffer_append(attributes, (const void*)&attribute, sizeof(struct xml_attribute)))
+			{
+				return 0;
+			}
+
+			++element.attributes_count;
+		}
+	}
+
+	element.children_position = buffer_size(children) / sizeof(struct range);
+	element.children_count = -1;
+
+	if (NULL != start)
+	{
+		uint8_t sub_nodes_buffer[BUFFER_SIZE_OF];
+		void* sub_nodes = (void*)sub_nodes_buffer;
+
+		if (!buffer_init(sub_nodes, BUFFER_SIZE_OF))
+		{
+			return 0;
+		}
+
+		element.children_count = xml_scan_sub_nodes_elements(start, finish, NULL, sub_nodes);
+
+		if (!element.children_count && buffer_size(sub_nodes))
+		{
+			element.children_count = -1;
+		}
+		else if (!buffer_append_data_from_buffer(children, sub_nodes))
+		{
+			buffer_release(sub_nodes);
+			return 0;
+		}
+
+		buffer_release(sub_nodes);
+	}
+
+	if (!buffer_append(elements, (const void*)&element, sizeof(struct xml_element)))
+	{
+		return 0;
+	}
+
+	for (ptrdiff_t i = 0; i < element.children_count; ++i)
+	{
+		const struct range child = *buffer_range_data(children, element.children_position + i);
+
+		if (!xml_index_add_element(index, child.start, child.finish, 0))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+uint8_t xml_index_new(const uint8_t* start, const uint8_t* finish, void* index)
+{
+	if (range_in_parts_is_null_or_empty(start, finish) ||
+		NULL == index)
+	{
+		return 0;
+	}
+
+	xml_index_release(index);
+
+	if (!common_get_attributes_and_arguments_for_task(
+			NULL, NULL, XML_INDEX_COUNT_OF_POSITIONS, NULL, NULL, NULL, index) ||
+		!xml_index_add_element(index, start, finish, 1))
+	{
+		buffer_release_with_inner_buffers(index);
+		return 0;
+	}
+
+	return 1;
+}
+
+void xml_index_release(void* index)
+{
+	if (NULL == index)
+	{
+		return;
+	}
+
+	buffer_release_with_inner_buffers(index);
+}